@@ -27,14 +27,35 @@ namespace disposer{
 
 		/// \brief The indexes of the modules that depend on this module
 		std::vector< std::size_t > next_indexes;
+
+		/// \brief true if the module produces or consumes a stream
+		///
+		/// Such modules must run in parallel to their stream partner.
+		bool uses_stream = false;
+
+		/// \brief The indexes of the modules whose outputs this module reads
+		///
+		/// Unlike the edges in next_indexes, this list is not reduced
+		/// transitively, it is used to run the module near its data.
+		std::vector< std::size_t > producer_indexes;
+
+		/// \brief The indexes of the modules that read outputs of this
+		///        module
+		///
+		/// The inverse of producer_indexes, it is used to place the output
+		/// data on the NUMA node of its consumers.
+		std::vector< std::size_t > consumer_indexes = {};
 	};
 
 	/// \brief List of a chains modules and indexes of the start modules
 	struct chain_module_list{
-		/// \brief Indexes in modules of all modules without active inputs
+		/// \brief Indexes in modules of all modules without precursors
 		std::vector< std::size_t > start_indexes;
 
 		/// \brief List of modules and there execution data
+		///
+		/// The modules are in config order, which is a topological order:
+		/// every next index is greater than the index of its module.
 		std::vector< chain_module_data > modules;
 	};
 
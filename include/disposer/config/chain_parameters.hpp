@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__config__chain_parameters__hpp_INCLUDED_
+#define _disposer__config__chain_parameters__hpp_INCLUDED_
+
+#include "embedded_config.hpp"
+
+#include <chrono>
+
+
+namespace disposer{
+
+
+	/// \brief How the modules of a chain are executed
+	enum class chain_executor{
+		/// \brief Every module is started asynchronously as soon as its
+		///        precursors are ready
+		parallel,
+
+		/// \brief All modules run one after another on the thread that
+		///        called exec(), streams behave like normal outputs
+		caller_thread,
+
+		/// \brief The modules run on the workers of the system executor,
+		///        a ready module is run by the same worker if dispatching
+		///        it costs more than it gains
+		adaptive
+	};
+
+
+	/// \brief How the execs of a chain are distributed to its replicas
+	enum class chain_distribution{
+		/// \brief The replicas are used one after another
+		round_robin,
+
+		/// \brief The replica with the fewest running execs is used
+		least_loaded
+	};
+
+
+	/// \brief Settings of a chain from its config parameter block
+	///
+	/// \code
+	/// chain
+	/// 	name
+	/// 		parameter
+	/// 			executor = inline
+	/// 		module
+	/// \endcode
+	struct chain_parameters{
+		/// \brief Config key 'executor', values 'parallel', 'inline' and
+		///        'adaptive'
+		chain_executor executor = chain_executor::parallel;
+
+		/// \brief Config key 'replicas', count of independent instances of
+		///        all modules of the chain
+		std::size_t replicas = 1;
+
+		/// \brief Config key 'distribution', values 'round_robin' and
+		///        'least_loaded'
+		chain_distribution distribution = chain_distribution::round_robin;
+
+		/// \brief Config key 'in_order', values 'true' and 'false'
+		///
+		/// If true, an exec() call returns not before all exec() calls
+		/// that started earlier returned.
+		bool in_order = false;
+
+		/// \brief Config key 'priority', integer, modules of chains with a
+		///        higher priority run first on the system executor
+		///
+		/// priority, weight and deadline require executor 'adaptive'.
+		int priority = 0;
+
+		/// \brief Config key 'weight', positive integer, share of the
+		///        system executor relative to chains of the same priority
+		std::size_t weight = 1;
+
+		/// \brief Config key 'deadline', milliseconds after the start of an
+		///        exec until it should be done, 0 if none
+		///
+		/// Modules of execs with an earlier deadline run first on the
+		/// system executor.
+		std::chrono::milliseconds deadline{0};
+
+		/// \brief Config key 'details', values 'true' and 'false'
+		///
+		/// If true, every exec() returns the timing and outcome of all
+		/// modules in exec_info::details.
+		bool details = false;
+	};
+
+
+	/// \brief Interpret the parameters of a chain config
+	///
+	/// Throws std::logic_error on unknown keys, invalid values or a
+	/// scheduling key without executor 'adaptive'.
+	chain_parameters make_chain_parameters(
+		types::embedded_config::chain const& config_chain);
+
+
+}
+
+
+#endif
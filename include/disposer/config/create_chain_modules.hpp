@@ -11,6 +11,7 @@
 
 #include "embedded_config.hpp"
 #include "chain_module_list.hpp"
+#include "chain_parameters.hpp"
 
 #include "../tool/module_ptr.hpp"
 
@@ -22,7 +23,8 @@ namespace disposer{
 	chain_module_list create_chain_modules(
 		module_maker_list const& module_makers,
 		component_module_makers_list& component_module_makers,
-		types::embedded_config::chain const& config_chain
+		types::embedded_config::chain const& config_chain,
+		chain_parameters const& parameters
 	);
 
 
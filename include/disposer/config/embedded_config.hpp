@@ -67,6 +67,7 @@ namespace disposer{
 			std::string name;
 			std::string id_generator;
 			std::vector< module > modules;
+			std::map< std::string, std::string, std::less<> > parameters;
 		};
 
 		using chains_config = std::vector< chain >;
@@ -81,10 +81,16 @@ namespace disposer{
 			std::vector< out > outputs;
 		};
 
+		struct chain_parameter{
+			std::string key;
+			std::string value;
+		};
+
 		struct chain{
 			std::string name;
 			std::optional< std::string > id_generator;
 			std::vector< module > modules;
+			std::vector< chain_parameter > parameters;
 		};
 
 		using chains = std::vector< chain >;
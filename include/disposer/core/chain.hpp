@@ -10,13 +10,21 @@
 #define _disposer__core__chain__hpp_INCLUDED_
 
 #include "id_generator.hpp"
+#include "exec_values.hpp"
 #include "exec_info.hpp"
+#include "memo_metrics.hpp"
+#include "memory_usage.hpp"
+#include "executor.hpp"
+
+#include "../tool/moving_average.hpp"
 
 #include "../config/chain_module_list.hpp"
+#include "../config/chain_parameters.hpp"
 #include "../config/embedded_config.hpp"
 
 #include <mutex>
 #include <condition_variable>
+#include <deque>
 
 
 namespace disposer{
@@ -35,17 +43,26 @@ namespace disposer{
 	/// - no 2 identical modules (in different executions) must running
 	///   simultaneously
 	/// - it must not be overtaken
+	///
+	/// With the chain parameter replicas = N the modules are created N
+	/// times. Every exec() runs on one of these independent replicas, so
+	/// modules with state can run N execs at the same time. A module that
+	/// can't run concurrently orders the execs of its own replica.
 	class chain{
 	public:
 		/// \brief Construct a proccess chain
 		///
 		/// \param config_chain configuration data from config file
 		/// \param generate_id Reference to a id_generator
+		/// \param system_memory Memory accounting of the system
+		/// \param executor Worker threads of the system
 		chain(
 			module_maker_list const& module_makers,
 			component_module_makers_list& component_module_makers,
 			types::embedded_config::chain const& config_chain,
-			id_generator& generate_id
+			id_generator& generate_id,
+			memory_usage& system_memory,
+			executor& executor
 		);
 
 
@@ -70,8 +87,29 @@ namespace disposer{
 		/// \brief Execute the proccess chain
 		///
 		/// The chain must be enabled, otherwise an exception is thrown.
+		///
+		/// If the chain or the system is over its memory budget, the call
+		/// blocks until enough output data of running execs is released.
 		exec_info exec();
 
+		/// \brief Execute the proccess chain
+		///
+		/// Like exec(), if details is true the result contains the timing
+		/// and outcome of every module. exec() collects them only if the
+		/// chain parameter 'details' is true.
+		exec_info exec(bool details);
+
+		/// \brief Execute the proccess chain with arguments
+		///
+		/// Like exec(), the modules of the exec can take the arguments by
+		/// move, see \ref external_input.
+		exec_info exec(exec_arguments arguments);
+
+		/// \brief Execute the proccess chain with arguments
+		///
+		/// Like exec(exec_arguments), with details as in exec(bool).
+		exec_info exec(exec_arguments arguments, bool details);
+
 
 		/// \brief Enables the chain for exec calls
 		///
@@ -98,22 +136,111 @@ namespace disposer{
 		}
 
 
+		/// \brief Bytes held by output data of running execs
+		///
+		/// Use memory().set_budget() to limit the admission of new execs.
+		memory_usage& memory()noexcept{
+			return memory_;
+		}
+
+		/// \brief Bytes held by output data of running execs
+		memory_usage const& memory()const noexcept{
+			return memory_;
+		}
+
+
+		/// \brief Settings from the chain config
+		chain_parameters const& parameters()const noexcept{
+			return parameters_;
+		}
+
+		/// \brief Count of independent instances of the modules
+		std::size_t replica_count()const noexcept{
+			return replicas_.size();
+		}
+
+		/// \brief Output cache metrics of all memoized modules of all
+		///        replicas
+		std::vector< module_memo_metrics > memoization()const;
+
+
 		/// \brief Name of the chain
 		std::string const name;
 
 
 	private:
-		/// \brief List of modules
-		chain_module_list const modules_;
+		/// \brief One instance of all modules of the chain
+		struct replica{
+			/// \brief Constructor
+			replica(chain_module_list&& list)
+				: modules(std::move(list)) {}
+
+			/// \brief List of modules
+			chain_module_list const modules;
+
+			/// \brief Exec id of the modules for least_loaded distribution
+			id_generator generate_exec_id;
+
+			/// \brief Count of running execs
+			std::atomic< std::size_t > running{0};
+		};
+
+
+		/// \brief Choose the replica for an exec and the exec id of its
+		///        modules
+		std::pair< replica&, std::size_t > select_replica(
+			std::size_t exec_id);
+
+		/// \brief Enable all modules of a replica
+		///
+		/// If a module throws, the already enabled ones are disabled.
+		void enable_modules(chain_module_list const& modules);
+
+		/// \brief Disable all modules of a replica
+		void disable_modules(chain_module_list const& modules)noexcept;
+
+
+		/// \brief Settings from the chain config
+		chain_parameters const parameters_;
+
+		/// \brief Independent instances of the modules
+		std::deque< replica > replicas_;
+
+		/// \brief Protects the least_loaded replica selection
+		std::mutex select_mutex_;
 
 
 		/// \brief Referenz to the global id_generator
+		///
+		/// Shared by many chains, so it reserves blocks of id's per thread.
 		id_generator& generate_id_;
 
 		/// \brief Chain local id generator
+		///
+		/// Dense and in call order, see no_overtaking.
 		id_generator generate_exec_id_;
 
 
+		/// \brief Accounting of the output data of running execs
+		memory_usage memory_;
+
+
+		/// \brief Worker threads of the system
+		executor& executor_;
+
+		/// \brief Priority, weight and deadline of the modules on the
+		///        system executor
+		scheduling_class scheduling_;
+
+		/// \brief Average exec time per module, used by the adaptive
+		///        executor
+		std::unique_ptr< moving_average[] > const exec_times_;
+
+		/// \brief Average time between posting a module to the executor
+		///        and its start
+		moving_average dispatch_time_;
+
+
 		/// \brief Mutex for enable and disable
 		std::mutex enable_mutex_;
 
@@ -126,6 +253,17 @@ namespace disposer{
 
 		/// \brief Manages exec() and enable() / disable() calls
 		std::condition_variable enable_cv_;
+
+
+		/// \brief Exec id of the next exec() that may return if in_order
+		///        is set
+		std::size_t next_result_ = 0;
+
+		/// \brief Protects next_result_
+		std::mutex result_mutex_;
+
+		/// \brief Signaled if next_result_ changed
+		std::condition_variable result_cv_;
 	};
 
 
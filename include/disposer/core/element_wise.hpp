@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__element_wise__hpp_INCLUDED_
+#define _disposer__core__element_wise__hpp_INCLUDED_
+
+#include "input_name.hpp"
+#include "output_name.hpp"
+
+#include <functional>
+
+
+namespace disposer{
+
+
+	/// \brief Exec function of a module that maps every element of an input
+	///        independently to one element of an output
+	///
+	/// Usage:
+	///
+	/// \code
+	/// exec_fn(element_wise("in"_in, "out"_out,
+	/// 	[](auto const& module, auto const& element){ return … }))
+	/// \endcode
+	///
+	/// Fn is called with (module, element) or with (element). The input
+	/// elements are split into chunks which run in parallel on the workers
+	/// of the system executor. The results are appended to the output in
+	/// input order. Fn must not use push() or emplace() of the output.
+	///
+	/// If the output is a stream, the elements are processed one after
+	/// another, so the consumer still gets them in order.
+	template < typename InputName, typename OutputName, typename Fn >
+	class element_wise{
+	public:
+		/// \brief Constructor
+		constexpr element_wise(InputName input, OutputName output, Fn fn)
+			: input_(input)
+			, output_(output)
+			, fn_(std::move(fn)) {}
+
+
+		/// \brief Process all elements of the input
+		template < typename ModuleRef >
+		void operator()(ModuleRef& module)const{
+			auto const data = module(input_).references();
+			auto& output = module(output_);
+
+			if(output.is_stream()){
+				for(std::size_t i = 0; i < data.size(); ++i){
+					output.push(call(module, data[i]));
+				}
+				return;
+			}
+
+			module.parallel_chunks(data.size(),
+				[this, &module, &data, &output](
+					std::size_t const begin,
+					std::size_t const end
+				){
+					auto appender = output.appender(begin);
+					appender.reserve(end - begin);
+					for(auto i = begin; i < end; ++i){
+						appender.push(call(module, data[i]));
+					}
+				});
+		}
+
+
+	private:
+		/// \brief Call fn_ with or without the module
+		template < typename ModuleRef, typename Element >
+		decltype(auto) call(
+			ModuleRef const& module,
+			Element const& element
+		)const{
+			if constexpr(
+				std::is_invocable_v< Fn const, ModuleRef const&,
+					Element const& >
+			){
+				return std::invoke(fn_, module, element);
+			}else{
+				(void)module; // silance GCC
+				return std::invoke(fn_, element);
+			}
+		}
+
+
+		/// \brief Name of the input
+		InputName input_;
+
+		/// \brief Name of the output
+		OutputName output_;
+
+		/// \brief The element function
+		Fn fn_;
+	};
+
+
+}
+
+
+#endif
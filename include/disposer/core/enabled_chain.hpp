@@ -42,6 +42,16 @@ namespace disposer{
 			return chain_.exec();
 		}
 
+		/// \brief Exec chain, with per module details if requested
+		exec_info exec(bool const details)noexcept{
+			return chain_.exec(details);
+		}
+
+		/// \brief Exec chain with arguments
+		exec_info exec(exec_arguments arguments){
+			return chain_.exec(std::move(arguments));
+		}
+
 		/// \brief Get name of the chain
 		std::string const& name()const noexcept{
 			return chain_.name;
@@ -10,11 +10,105 @@
 #define _disposer__core__exec_fn__hpp_INCLUDED_
 
 #include "module_ref.hpp"
+#include "memoize.hpp"
 
 
 namespace disposer{
 
 
+	/// \brief Marks an exec function as free of side effects
+	///
+	/// Usage: exec_fn(pure([](auto module){ … }))
+	///
+	/// A pure module only reads its inputs and parameters and writes its
+	/// outputs. If none of its outputs is used by a module that is not
+	/// removed itself, the chain drops the module at construction.
+	///
+	/// With a \ref memoize setting the module caches its outputs per input
+	/// combination: exec_fn(pure([](auto module){ … }, memoize(16)))
+	template < typename Fn, typename Memoize = void >
+	class pure{
+	public:
+		constexpr explicit pure(Fn const& fn)
+			noexcept(std::is_nothrow_copy_constructible_v< Fn >)
+			: fn_(fn) {}
+
+		constexpr explicit pure(Fn&& fn)
+			noexcept(std::is_nothrow_move_constructible_v< Fn >)
+			: fn_(std::move(fn)) {}
+
+		/// \brief Calls the function with the same arguments
+		template < typename ... Ref >
+		auto operator()(Ref&& ... ref)
+			-> std::invoke_result_t< Fn&, Ref ... >
+		{
+			return std::invoke(fn_, static_cast< Ref&& >(ref) ...);
+		}
+
+	private:
+		Fn fn_;
+	};
+
+	/// \brief A pure exec function with an output cache
+	template < typename Fn, typename Hasher >
+	class pure< Fn, memoize< Hasher > >{
+	public:
+		pure(Fn fn, memoize< Hasher > config)
+			: fn_(std::move(fn))
+			, config_(std::move(config))
+			, cache_(std::make_unique< memo_cache< Hasher > >(config_)) {}
+
+		/// \brief Every copy has its own empty cache
+		pure(pure const& other)
+			: pure(other.fn_, other.config_) {}
+
+		pure(pure&&) = default;
+
+
+		/// \brief Reuse cached outputs or call the function
+		template < typename ModuleRef >
+		void operator()(ModuleRef& module){
+			cache_->exec(module, fn_);
+		}
+
+		/// \brief Snapshot of the cache state
+		memo_metrics metrics()const{
+			return cache_->metrics();
+		}
+
+		/// \brief Remove all cached outputs
+		void clear()noexcept{
+			cache_->clear();
+		}
+
+	private:
+		Fn fn_;
+		memoize< Hasher > config_;
+		std::unique_ptr< memo_cache< Hasher > > cache_;
+	};
+
+	template < typename Fn >
+	pure(Fn) -> pure< Fn >;
+
+	template < typename Fn, typename Hasher >
+	pure(Fn, memoize< Hasher >) -> pure< Fn, memoize< Hasher > >;
+
+
+	/// \brief true if Fn is a \ref pure exec function
+	template < typename Fn >
+	constexpr bool is_pure_v = false;
+
+	template < typename Fn, typename Memoize >
+	constexpr bool is_pure_v< pure< Fn, Memoize > > = true;
+
+	/// \brief true if Fn is a \ref pure exec function with a cache
+	template < typename Fn >
+	constexpr bool is_memoized_v = false;
+
+	template < typename Fn, typename Hasher >
+	constexpr bool is_memoized_v< pure< Fn, memoize< Hasher > > > = true;
+
+
 	/// \brief Wrapper for the module exec function
 	template < typename Fn >
 	class exec_fn{
@@ -60,6 +154,17 @@ namespace disposer{
 		}
 
 
+		/// \brief The wrapped function
+		Fn const& fn()const noexcept{
+			return fn_;
+		}
+
+		/// \brief The wrapped function
+		Fn& fn()noexcept{
+			return fn_;
+		}
+
+
 	private:
 		Fn fn_;
 	};
@@ -9,12 +9,78 @@
 #ifndef _disposer__core__exec_info__hpp_INCLUDED_
 #define _disposer__core__exec_info__hpp_INCLUDED_
 
-#include <cstddef>
+#include "exec_values.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
 
 
 namespace disposer{
 
 
+	/// \brief What happend to a module in an exec
+	enum class module_outcome{
+		/// \brief exec_fn returned normally
+		success,
+
+		/// \brief exec_fn threw
+		failed,
+
+		/// \brief Not executed because a precursor failed
+		skipped
+	};
+
+
+	/// \brief Timing and outcome of a module in an exec
+	struct module_exec_info{
+		using time_point = std::chrono::steady_clock::time_point;
+
+		/// \brief Position of the module in the chain, starting with 1
+		std::size_t number;
+
+		/// \brief Name of the module type
+		std::string type_name;
+
+		/// \brief What happend to the module
+		module_outcome outcome = module_outcome::skipped;
+
+		/// \brief Start of the exec, including wait
+		time_point start{};
+
+		/// \brief End of the exec
+		time_point end{};
+
+		/// \brief Time a no_overtaking module waited for the previous exec
+		std::chrono::nanoseconds wait{0};
+	};
+
+
+	/// \brief Per module breakdown of an exec
+	struct exec_details{
+		using time_point = std::chrono::steady_clock::time_point;
+
+		/// \brief Start of the exec() call
+		time_point start{};
+
+		/// \brief End of the exec
+		time_point end{};
+
+		/// \brief All modules in chain order
+		std::vector< module_exec_info > modules;
+
+
+		/// \brief The first failed module in chain order, nullptr if none
+		module_exec_info const* failed_module()const noexcept{
+			for(auto const& module: modules){
+				if(module.outcome == module_outcome::failed) return &module;
+			}
+			return nullptr;
+		}
+	};
+
+
 	/// \brief Returned by an exec call
 	struct exec_info{
 		/// \brief true if exec was successfully executed, false otherwise
@@ -26,6 +92,14 @@ namespace disposer{
 		/// \brief Chain local execution ID
 		std::size_t exec_id;
 
+		/// \brief Per module breakdown if requested, nullptr otherwise
+		///
+		/// See chain::exec(bool) and the chain parameter 'details'.
+		std::shared_ptr< exec_details const > details;
+
+		/// \brief Values the modules returned, see \ref external_output
+		exec_results results;
+
 
 		/// \brief Implicit conversion to bool
 		constexpr operator bool()const noexcept{
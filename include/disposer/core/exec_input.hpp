@@ -11,8 +11,10 @@
 
 #include "exec_input_base.hpp"
 #include "exec_output.hpp"
+#include "input_stream.hpp"
 
 #include "../tool/input_data.hpp"
+#include "../tool/to_std_string.hpp"
 
 
 namespace disposer{
@@ -49,25 +51,48 @@ namespace disposer{
 
 		/// \brief Is the input connected to an output
 		bool is_connected()noexcept{
-			static_assert(IsRequired,
+			static_assert(!IsRequired,
 				"Input is required and therefore always connected! "
 				"Just don't ask ;-)");
 
 			return output_ptr() != nullptr;
 		}
 
+		/// \brief true if the connected output passes the data element by
+		///        element while its producer is running
+		bool is_stream()const noexcept{
+			return output_ptr() && output_ptr()->is_stream();
+		}
+
 		/// \brief Get all data without transferring ownership
+		///
+		/// If the connected output is a stream, this waits until the
+		/// producing module finished.
 		input_data_r< T > references(){
 			verify_connection();
+			output_ptr()->receive_stream();
 			return output_ptr()->references();
 		}
 
 		/// \brief Get all data with transferring ownership
+		///
+		/// If the connected output is a stream, this waits until the
+		/// producing module finished.
 		input_data_v< T > values(){
 			verify_connection();
+			output_ptr()->receive_stream();
 			return output_ptr()->values();
 		}
 
+		/// \brief Get the data element by element
+		///
+		/// If the connected output is a stream, every element is available as
+		/// soon as the producing module pushed it.
+		input_stream< T > stream(){
+			verify_connection();
+			return input_stream< T >(*output_ptr());
+		}
+
 		/// \brief Tell the connected output that this input finished
 		void cleanup()noexcept{
 			if(output_ptr()){
@@ -85,7 +110,7 @@ namespace disposer{
 
 		void verify_connection()noexcept(IsRequired){
 			if constexpr(!IsRequired) if(!output_ptr()){
-				throw std::logic_error("input(" + to_std_string(name)
+				throw std::logic_error("input(" + detail::to_std_string(name)
 					+ ") is not linked to an output");
 			}
 		}
@@ -103,12 +103,29 @@ namespace disposer{
 
 		/// \brief The actual worker function called one times per trigger
 		virtual bool exec()noexcept override{
-			return module().exec(*this);
+			auto const details = this->exec_details();
+			if(details) details->start = std::chrono::steady_clock::now();
+
+			auto const success = module().exec(*this);
+			hana::for_each(outputs_,
+				[success](auto& output){ output.close(success); });
+
+			if(details){
+				details->end = std::chrono::steady_clock::now();
+				details->outcome = success
+					? module_outcome::success : module_outcome::failed;
+			}
+
+			return success;
 		}
 
 		/// \brief Cleanup inputs and connected outputs if appropriate
+		///
+		/// Stream outputs of a module that was not executed are closed as
+		/// failed.
 		virtual void cleanup()noexcept override{
 			hana::for_each(inputs_, [](auto& input){ input.cleanup(); });
+			hana::for_each(outputs_, [](auto& output){ output.close(false); });
 		}
 	};
 
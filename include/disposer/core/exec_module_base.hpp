@@ -10,6 +10,8 @@
 #define _disposer__core__exec_module_base__hpp_INCLUDED_
 
 #include "exec_input_base.hpp"
+#include "exec_values.hpp"
+#include "exec_info.hpp"
 #include "module_base.hpp"
 
 #include <logsys/log_base.hpp>
@@ -20,6 +22,10 @@
 namespace disposer{
 
 
+	class executor;
+	class scheduling_class;
+
+
 	/// \brief Base class for module exec object
 	class exec_module_base: public logsys::log_base{
 	public:
@@ -92,6 +98,66 @@ namespace disposer{
 		}
 
 
+		/// \brief Worker threads for parallel algorithms inside the exec,
+		///        nullptr if the module runs outside of a chain
+		disposer::executor* executor()const noexcept{
+			return executor_;
+		}
+
+		/// \brief Scheduling class of the chain, nullptr if the module runs
+		///        outside of a chain
+		scheduling_class* scheduling()const noexcept{
+			return scheduling_;
+		}
+
+		/// \brief Set by the chain before the exec
+		void set_executor(
+			disposer::executor& executor,
+			scheduling_class& scheduling
+		)noexcept{
+			executor_ = &executor;
+			scheduling_ = &scheduling;
+		}
+
+
+		/// \brief Values the caller passed to the exec
+		///
+		/// Empty if the module runs outside of a chain.
+		exec_arguments& arguments()const noexcept{
+			static exec_arguments none;
+			return arguments_ ? *arguments_ : none;
+		}
+
+		/// \brief Set by the chain before the exec
+		void set_arguments(exec_arguments& arguments)noexcept{
+			arguments_ = &arguments;
+		}
+
+
+		/// \brief Values the exec returns to the caller, nullptr if the
+		///        module runs outside of a chain
+		exec_results* results()const noexcept{
+			return results_;
+		}
+
+		/// \brief Set by the chain before the exec
+		void set_results(exec_results& results)noexcept{
+			results_ = &results;
+		}
+
+
+		/// \brief Record of the exec timing and outcome, nullptr if the
+		///        exec doesn't collect details
+		module_exec_info* exec_details()const noexcept{
+			return exec_details_;
+		}
+
+		/// \brief Set by the chain before the exec if it collects details
+		void set_exec_details(module_exec_info* details)noexcept{
+			exec_details_ = details;
+		}
+
+
 	protected:
 		/// \brief Reference to the module
 		module_base& module_;
@@ -107,6 +173,21 @@ namespace disposer{
 		///
 		/// This id is bound to the chain.
 		std::size_t exec_id_;
+
+		/// \brief Worker threads for parallel algorithms
+		disposer::executor* executor_ = nullptr;
+
+		/// \brief Scheduling class of the chain
+		scheduling_class* scheduling_ = nullptr;
+
+		/// \brief Record of the exec timing and outcome
+		module_exec_info* exec_details_ = nullptr;
+
+		/// \brief Values the caller passed to the exec
+		exec_arguments* arguments_ = nullptr;
+
+		/// \brief Values the exec returns to the caller
+		exec_results* results_ = nullptr;
 	};
 
 
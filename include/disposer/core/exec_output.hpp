@@ -12,8 +12,12 @@
 #include "exec_output_base.hpp"
 #include "output_map_type.hpp"
 #include "output.hpp"
+#include "output_appender.hpp"
 
 #include "../tool/input_data.hpp"
+#include "../tool/stream_channel.hpp"
+#include "../tool/mapped_buffer.hpp"
+#include "../tool/adopted_buffer.hpp"
 #include "../tool/to_std_string_view.hpp"
 
 #include <io_tools/make_string.hpp>
@@ -23,7 +27,10 @@
 #include <boost/hana/tuple.hpp>
 
 #include <functional>
+#include <algorithm>
 #include <variant>
+#include <cstring>
+#include <mutex>
 
 
 namespace disposer{
@@ -38,40 +45,170 @@ namespace disposer{
 		/// \brief The actual type
 		using type = T;
 
+		/// \brief true if the data can be moved into a mapped file
+		static constexpr bool is_spillable = is_spillable_type< T >;
+
 
 		/// \brief Constructor
 		unnamed_exec_output(
 			std::size_t const id,
 			std::string&& log_prefix,
 			std::string_view name,
-			std::size_t use_count
+			std::size_t use_count,
+			std::size_t stream_capacity = 0,
+			std::size_t spill_threshold = 0
 		)noexcept
 			: exec_output_base(use_count)
 			, logsys::log_base(io_tools::make_string("id(", id, ") ",
-				std::move(log_prefix), "output(", name, ") ")) {}
+				std::move(log_prefix), "output(", name, ") "))
+			, spill_threshold_(spill_threshold)
+		{
+			if(stream_capacity > 0) stream_.emplace(stream_capacity);
+		}
 
 
 		/// \brief Add given data to \ref data_
+		///
+		/// If the output is a stream, the data is passed to the connected
+		/// input immediately.
 		template < typename ... Args >
 		void emplace(Args&& ... args){
-			data_.emplace_back(static_cast< Args&& >(args) ...);
+			if(stream_){
+				stream_->emplace(static_cast< Args&& >(args) ...);
+			}else{
+				data_.emplace_back(static_cast< Args&& >(args) ...);
+				account(data_.back());
+			}
 		}
 
 		/// \brief Add given data to \ref data_
+		///
+		/// If the output is a stream, the data is passed to the connected
+		/// input immediately.
 		template < typename Arg >
 		void push(Arg&& value){
-			data_.push_back(static_cast< Arg&& >(value));
+			if(stream_){
+				stream_->emplace(static_cast< Arg&& >(value));
+			}else{
+				data_.push_back(static_cast< Arg&& >(value));
+				account(data_.back());
+			}
+		}
+
+
+		/// \brief Add a view of memory owned elsewhere without copying it
+		///
+		/// Only available if T is an adopted_buffer. release() runs after
+		/// the last consumer dropped the element, it must not throw.
+		template < typename U, typename Release >
+		void push_external(U const* data, std::size_t size, Release&& release){
+			static_assert(std::is_same_v< T, adopted_buffer< U > >,
+				"push_external requires an output of type adopted_buffer< U >");
+			emplace(data, size, static_cast< Release&& >(release));
+		}
+
+
+		/// \brief Create a buffer to add elements from a parallel thread
+		///
+		/// push() and emplace() are not thread-safe, an appender is. See
+		/// \ref output_appender.
+		output_appender< T > appender(std::size_t const order = 0)noexcept{
+			return output_appender< T >(*this, order);
+		}
+
+
+		/// \brief true if the data is passed element by element
+		bool is_stream()const noexcept{
+			return stream_.has_value();
+		}
+
+		/// \brief Get the next element
+		///
+		/// For streams this blocks until the producer pushed the next element
+		/// or finished. Otherwise the element at position cursor is returned,
+		/// it is moved out on the last use of the output. After
+		/// receive_stream() the remaining elements of a stream are read from
+		/// the data too.
+		std::optional< T > pop(std::size_t& cursor){
+			if(stream_ && !stream_received_) return stream_->pop();
+
+			if constexpr(is_spillable){
+				if(is_spilled()){
+					if(cursor >= spill_size_) return {};
+					return std::optional< T >(spilled_data()[cursor++]);
+				}
+			}
+
+			if(cursor >= data_.size()) return {};
+			if(is_last_use()){
+				return std::optional< T >(std::move(data_[cursor++]));
+			}else{
+				return std::optional< T >(data_[cursor++]);
+			}
+		}
+
+		/// \brief Wait for all elements of a stream and store them in
+		///        \ref data_
+		void receive_stream(){
+			if(!stream_ || stream_received_) return;
+			while(auto value = stream_->pop()){
+				data_.push_back(std::move(*value));
+				account(data_.back());
+			}
+			stream_received_ = true;
+		}
+
+		/// \brief Called after the producing module finished
+		///
+		/// Wakes up a consumer waiting on the stream. A spillable output is
+		/// moved to a mapped file if it is large enough or if memory is
+		/// short.
+		void close(bool const success)noexcept{
+			merge_chunks();
+
+			if(stream_){
+				stream_->close(success);
+			}else if(success && spill_threshold_ > 0){
+				spill();
+			}
+		}
+
+
+		/// \brief true if the data was moved to a mapped file
+		bool is_spilled()const noexcept{
+			if constexpr(is_spillable){
+				return spill_.has_value();
+			}else{
+				return false;
+			}
 		}
 
 
 		/// \brief Get a view to the data
 		input_data_r< T > references()const{
+			if constexpr(is_spillable){
+				if(is_spilled()){
+					return input_data_r< T >(spilled_data(), spill_size_);
+				}
+			}
 			return data_;
 		}
 
 		/// \brief Get a reference to the data
-		input_data_v< T > values()const{
+		///
+		/// On the last use the data is moved out of the output. Spilled data
+		/// is copied out of the mapped file.
+		input_data_v< T > values(){
+			if constexpr(is_spillable){
+				if(is_spilled()){
+					return std::vector< T >(
+						spilled_data(), spilled_data() + spill_size_);
+				}
+			}
+
 			if(is_last_use()){
+				memory_sub(bytes_);
+				bytes_ = 0;
 				return std::move(data_);
 			}else{
 				return data_;
@@ -80,21 +217,142 @@ namespace disposer{
 
 		/// \brief Remove data on last cleanup call
 		void cleanup()noexcept{
+			if(stream_) stream_->abandon();
+
 			if(is_cleanup()){
 				log(
 					[](logsys::stdlogb& os){
 						os << "cleanup";
 					},
 					[this]{
+						memory_sub(bytes_);
+						bytes_ = 0;
 						data_.clear();
+						if constexpr(is_spillable) spill_.reset();
 					});
 			}
 		}
 
 
+		/// \brief Append all committed appender buffers sorted by order
+		///
+		/// Called by close(). Exec helpers that need the complete data
+		/// before may call it after all appenders committed.
+		void merge_chunks()noexcept{
+			if(chunks_.empty()) return;
+
+			exception_catching_log(
+				[this](logsys::stdlogb& os){
+					os << "merge " << chunks_.size() << " appender buffers";
+				},
+				[this]{
+					std::stable_sort(chunks_.begin(), chunks_.end(),
+						[](auto const& a, auto const& b){
+							return a.first < b.first;
+						});
+
+					std::size_t count = data_.size();
+					for(auto const& chunk: chunks_){
+						count += chunk.second.size();
+					}
+					data_.reserve(count);
+
+					for(auto& chunk: chunks_){
+						for(auto&& value: chunk.second){
+							data_.push_back(std::move(value));
+							account(data_.back());
+						}
+					}
+					chunks_.clear();
+				});
+		}
+
+
 	private:
+		/// \brief Called by output_appender::commit()
+		void append_chunk(std::size_t const order, std::vector< T >&& data){
+			if(stream_){
+				for(auto&& value: data) stream_->emplace(std::move(value));
+				return;
+			}
+
+			std::lock_guard lock(chunks_mutex_);
+			chunks_.emplace_back(order, std::move(data));
+		}
+
+		friend class output_appender< T >;
+
+
+		/// \brief Account the bytes of a new element
+		///
+		/// Elements buffered in a stream are bounded by the stream capacity
+		/// and not accounted.
+		void account(T const& value){
+			auto const bytes = memory_size< T >{}(value);
+			bytes_ += bytes;
+			memory_add(bytes);
+		}
+
+		/// \brief Move the data to a mapped file if it is large enough or
+		///        if the chain or system is over its memory budget
+		///
+		/// If the file can not be created, the data stays in memory.
+		void spill()noexcept{
+			if constexpr(is_spillable){
+				if(data_.empty()) return;
+				if(bytes_ < spill_threshold_ && !memory_pressure()) return;
+
+				exception_catching_log(
+					[this](logsys::stdlogb& os){
+						os << "spill " << bytes_ << " bytes to mapped file";
+					},
+					[this]{
+						auto const size = data_.size() * sizeof(T);
+						spill_.emplace(size);
+						std::memcpy(spill_->data(), data_.data(), size);
+						spill_size_ = data_.size();
+
+						// release the memory, clear() would keep it
+						std::vector< T >().swap(data_);
+						memory_sub(bytes_);
+						bytes_ = 0;
+					});
+			}
+		}
+
+		/// \brief Begin of the data in the mapped file
+		T const* spilled_data()const noexcept{
+			return static_cast< T const* >(spill_->data());
+		}
+
+
 		/// \brief Putted data of the output
 		std::vector< T > data_;
+
+		/// \brief Accounted bytes of data_
+		std::size_t bytes_ = 0;
+
+		/// \brief Channel to the connected input if output is a stream
+		std::optional< stream_channel< T > > stream_;
+
+		/// \brief true after receive_stream() moved all elements of the
+		///        stream to data_
+		bool stream_received_ = false;
+
+		/// \brief Buffers committed by appenders, merged in close()
+		std::vector< std::pair< std::size_t, std::vector< T > > > chunks_;
+
+		/// \brief Protects chunks_
+		std::mutex chunks_mutex_;
+
+		/// \brief Size in bytes from which the data is spilled, 0 if never
+		std::size_t const spill_threshold_;
+
+		/// \brief Mapped file holding the data after spill()
+		std::optional< mapped_buffer > spill_;
+
+		/// \brief Count of elements in spill_
+		std::size_t spill_size_ = 0;
 	};
 
 
@@ -127,7 +385,9 @@ namespace disposer{
 				std::move(data.id),
 				std::move(data.module_log_prefix),
 				detail::to_std_string_view(name),
-				data.output.use_count()
+				data.output.use_count(),
+				data.output.is_stream() ? data.output.stream_capacity() : 0,
+				data.output.spill_threshold()
 			)
 		{
 			data.output_map.emplace(&data.output, this);
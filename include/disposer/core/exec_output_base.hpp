@@ -9,6 +9,8 @@
 #ifndef _disposer__core__exec_output_base__hpp_INCLUDED_
 #define _disposer__core__exec_output_base__hpp_INCLUDED_
 
+#include "memory_usage.hpp"
+
 #include "../tool/type_index.hpp"
 #include "../tool/any_type.hpp"
 
@@ -46,7 +48,36 @@ namespace disposer{
 		exec_output_base& operator=(exec_output_base&&) = delete;
 
 
+		/// \brief Set the object where the data of this output is accounted
+		void set_memory_usage(memory_usage* usage)noexcept{
+			memory_usage_ = usage;
+		}
+
+		/// \brief Object where the data of this output is accounted or
+		///        nullptr
+		memory_usage* memory()const noexcept{
+			return memory_usage_;
+		}
+
+
 	protected:
+		/// \brief Account bytes of new data
+		void memory_add(std::size_t const bytes)noexcept{
+			if(memory_usage_) memory_usage_->add(bytes);
+		}
+
+		/// \brief Account bytes of released or moved out data
+		void memory_sub(std::size_t const bytes)noexcept{
+			if(memory_usage_) memory_usage_->sub(bytes);
+		}
+
+
+		/// \brief true if the chain or system is over its memory budget
+		bool memory_pressure()const noexcept{
+			return memory_usage_ && memory_usage_->over_budget();
+		}
+
+
 		/// \brief true if remaining_use_count_ is 1, false otherwise
 		bool is_last_use()const noexcept{ return remaining_use_count_ == 1; }
 
@@ -61,6 +92,9 @@ namespace disposer{
 		/// \brief Data can only be moved to an input, if all previos
 		///        inputs are ready
 		std::atomic< std::size_t > remaining_use_count_;
+
+		/// \brief Accounting object of the chain or nullptr
+		memory_usage* memory_usage_ = nullptr;
 	};
 
 
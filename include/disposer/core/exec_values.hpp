@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__exec_values__hpp_INCLUDED_
+#define _disposer__core__exec_values__hpp_INCLUDED_
+
+#include "../tool/type_index.hpp"
+
+#include <string_view>
+#include <stdexcept>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace disposer{
+
+
+	/// \brief Named values of any movable type, taken by move
+	///
+	/// Used for the arguments a caller passes to an exec of a chain, see
+	/// \ref external_input, and for the results an exec returns, see
+	/// \ref external_output. Every value can be taken once.
+	///
+	/// \code
+	/// exec_arguments arguments;
+	/// arguments.emplace("frame", std::move(frame));
+	/// auto info = chain.exec(std::move(arguments));
+	/// auto result = info.results.take< std::vector< int > >("count");
+	/// \endcode
+	///
+	/// emplace() may be called concurrently, take() may be called
+	/// concurrently for different keys, but not both at the same time.
+	class exec_values{
+	public:
+		/// \brief Constructor
+		exec_values() = default;
+
+		/// \brief Move constructor, must not run concurrent to other calls
+		exec_values(exec_values&& other)noexcept
+			: values_(std::move(other.values_)) {}
+
+		/// \brief Move assignment, must not run concurrent to other calls
+		exec_values& operator=(exec_values&& other)noexcept{
+			values_ = std::move(other.values_);
+			return *this;
+		}
+
+
+		/// \brief Add a value
+		///
+		/// Throws std::logic_error if the key is already used.
+		template < typename T >
+		void emplace(std::string key, T&& value){
+			std::lock_guard lock(mutex_);
+			if(find(key) != nullptr){
+				throw std::logic_error("exec argument(" + key
+					+ ") is set twice");
+			}
+
+			using type = std::remove_cv_t< std::remove_reference_t< T > >;
+			values_.push_back(std::make_unique< holder< type > >(
+				std::move(key), static_cast< T&& >(value)));
+		}
+
+
+		/// \brief true if a value with the key exists and was not taken
+		bool contains(std::string_view const key)const noexcept{
+			auto const value = find(key);
+			return value != nullptr && !value->taken;
+		}
+
+		/// \brief Count of values
+		std::size_t size()const noexcept{
+			return values_.size();
+		}
+
+
+		/// \brief Move the value out
+		///
+		/// Throws std::logic_error if there is no value with the key, if it
+		/// was already taken or if it has not the type T. Different keys
+		/// may be taken concurrently.
+		template < typename T >
+		T take(std::string_view const key){
+			auto const value = find(key);
+			if(value == nullptr){
+				throw std::logic_error("exec argument(" + std::string(key)
+					+ ") doesn't exist");
+			}
+
+			auto const typed = dynamic_cast< holder< T >* >(value);
+			if(typed == nullptr){
+				throw std::logic_error("exec argument(" + std::string(key)
+					+ ") has type " + value->type().pretty_name()
+					+ " instead of "
+					+ type_index::type_id< T >().pretty_name());
+			}
+
+			if(value->taken.exchange(true)){
+				throw std::logic_error("exec argument(" + std::string(key)
+					+ ") was already taken");
+			}
+
+			return std::move(typed->data);
+		}
+
+
+	private:
+		/// \brief Type erased value
+		struct holder_base{
+			/// \brief Constructor
+			holder_base(std::string&& key)noexcept
+				: key(std::move(key)) {}
+
+			/// \brief Standard virtual destructor
+			virtual ~holder_base() = default;
+
+			/// \brief Type of the value
+			virtual type_index type()const noexcept = 0;
+
+			/// \brief Key of the value
+			std::string const key;
+
+			/// \brief true after take()
+			std::atomic< bool > taken{false};
+		};
+
+		/// \brief The value
+		template < typename T >
+		struct holder: holder_base{
+			/// \brief Constructor
+			template < typename U >
+			holder(std::string&& key, U&& data)
+				: holder_base(std::move(key))
+				, data(static_cast< U&& >(data)) {}
+
+			/// \brief Type of the value
+			type_index type()const noexcept override{
+				return type_index::type_id< T >();
+			}
+
+			/// \brief The value
+			T data;
+		};
+
+
+		/// \brief Value with the key or nullptr
+		holder_base* find(std::string_view const key)const noexcept{
+			for(auto const& value: values_){
+				if(value->key == key) return value.get();
+			}
+			return nullptr;
+		}
+
+
+		/// \brief The values in order of emplace()
+		///
+		/// An exec has only a few arguments, a linear search is fastest.
+		std::vector< std::unique_ptr< holder_base > > values_;
+
+		/// \brief Serializes emplace()
+		std::mutex mutex_;
+	};
+
+
+	/// \brief Values the caller passes to an exec
+	using exec_arguments = exec_values;
+
+	/// \brief Values an exec returns to the caller
+	using exec_results = exec_values;
+
+
+}
+
+
+#endif
@@ -0,0 +1,375 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__executor__hpp_INCLUDED_
+#define _disposer__core__executor__hpp_INCLUDED_
+
+#include "scheduling_class.hpp"
+
+#include "../tool/managed_blocking.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <list>
+
+
+namespace disposer{
+
+
+	/// \brief Snapshot of the state and the scaling history of an executor
+	struct executor_metrics{
+		/// \brief Current target count of not blocked workers
+		std::size_t worker_count;
+
+		/// \brief Highest worker_count so far
+		std::size_t peak_worker_count;
+
+		/// \brief Count of threads including compensation threads
+		std::size_t thread_count;
+
+		/// \brief Count of workers waiting for a task
+		std::size_t idle_worker_count;
+
+		/// \brief Count of queued tasks
+		std::size_t queue_size;
+
+		/// \brief How often a worker was added because of queued tasks
+		std::size_t grow_count;
+
+		/// \brief How often a worker ended because it was idle too long
+		std::size_t shrink_count;
+	};
+
+
+	/// \brief Worker thread pool of the system
+	///
+	/// The workers are started with the first post() call. If a worker
+	/// blocks inside a task (see \ref managed_blocking), a compensation
+	/// thread is started, so the count of not blocked workers stays at
+	/// worker_count(). Surplus threads end after the blocking is over.
+	///
+	/// Idle workers sleep on a condition variable by default. For latency
+	/// critical setups up to spinning_worker_count() idle workers busy poll
+	/// the queue for spin_duration() before they sleep, so a posted task
+	/// starts without a thread wakeup.
+	///
+	/// With set_elastic() the worker count follows the load: post() adds a
+	/// worker if more tasks are queued than workers are idle, a worker that
+	/// was idle for the idle timeout ends.
+	///
+	/// Queued tasks are ordered by their \ref scheduling_class, tasks of
+	/// the same class and deadline run in the order of their post() calls.
+	///
+	/// A task can be posted with the index of a preferred worker, e.g. the
+	/// one that produced the data the task reads. The task waits in a
+	/// local queue of that worker, which takes it before tasks of a lower
+	/// priority. Other workers take it only while the preferred worker is
+	/// busy.
+	class executor: private blocking_handler{
+	public:
+		/// \brief Type of the tasks, a task must not throw
+		using task = std::function< void() >;
+
+
+		/// \brief Constructor
+		///
+		/// \param worker_count Count of workers, 0 means one per hardware
+		///                     thread
+		explicit executor(std::size_t worker_count = 0);
+
+		/// \brief Run all remaining tasks and join all workers
+		~executor();
+
+		/// \brief Not copyable
+		executor(executor const&) = delete;
+
+		/// \brief Not copy-assignable
+		executor& operator=(executor const&) = delete;
+
+
+		/// \brief Type of deadlines
+		using time_point = std::chrono::steady_clock::time_point;
+
+		/// \brief Worker index of threads that are no workers
+		static constexpr std::size_t no_worker = std::size_t(-1);
+
+
+		/// \brief Queue a task of the default class for execution by a
+		///        worker
+		void post(task&& task);
+
+		/// \brief Queue a task for execution by a worker
+		///
+		/// If no worker thread can be started, the task is not queued and
+		/// the exception is rethrown. If at least one worker runs, a failed
+		/// start of another one is ignored, the task will run.
+		///
+		/// \param task The task
+		/// \param cls Scheduling class of the task, must live until the
+		///            task started
+		/// \param deadline Point in time until the task should be done,
+		///                 time_point::max() if it has none
+		/// \param worker Index of the preferred worker or no_worker
+		void post(
+			task&& task,
+			scheduling_class& cls,
+			time_point deadline = time_point::max(),
+			std::size_t worker = no_worker);
+
+
+		/// \brief Count of workers that are not blocked
+		std::size_t worker_count()const noexcept{
+			return worker_count_;
+		}
+
+		/// \brief Change the count of workers
+		///
+		/// This disables an elastic worker count.
+		void set_worker_count(std::size_t count);
+
+		/// \brief Let the worker count vary between min and max
+		///
+		/// \param min Lowest count of workers, 0 means one
+		/// \param max Highest count of workers, 0 means one per hardware
+		///            thread
+		/// \param idle_timeout Time after which an idle worker ends if more
+		///                     than min workers exist
+		void set_elastic(
+			std::size_t min,
+			std::size_t max,
+			std::chrono::nanoseconds idle_timeout = std::chrono::seconds(1));
+
+		/// \brief true if the worker count varies with the load
+		bool is_elastic()const noexcept{
+			return min_worker_count_ != max_worker_count_;
+		}
+
+		/// \brief Lowest count of workers
+		std::size_t min_worker_count()const noexcept{
+			return min_worker_count_;
+		}
+
+		/// \brief Highest count of workers
+		std::size_t max_worker_count()const noexcept{
+			return max_worker_count_;
+		}
+
+		/// \brief Current state and scaling history
+		executor_metrics metrics()const;
+
+		/// \brief Count of workers waiting for a task
+		std::size_t idle_worker_count()const noexcept{
+			return idle_;
+		}
+
+		/// \brief Count of queued tasks
+		std::size_t queue_size()const;
+
+
+		/// \brief Let up to count idle workers busy poll for new tasks
+		///
+		/// A spinning worker sleeps if no task arrived within duration.
+		/// A count of 0 disables spinning.
+		void set_spinning(
+			std::size_t count,
+			std::chrono::nanoseconds duration = std::chrono::milliseconds(1));
+
+		/// \brief Maximum count of idle workers that busy poll
+		std::size_t spinning_worker_count()const noexcept{
+			return spinning_worker_count_;
+		}
+
+		/// \brief Time an idle worker busy polls before it sleeps
+		std::chrono::nanoseconds spin_duration()const noexcept{
+			return spin_duration_;
+		}
+
+
+		/// \brief true if the calling thread is a worker of this executor
+		bool is_worker_thread()const noexcept;
+
+		/// \brief Index of the calling worker or no_worker
+		///
+		/// The index of an ended worker is reused by the next new one.
+		std::size_t current_worker()const noexcept;
+
+
+	private:
+		/// \brief Called by managed_blocking in a worker thread
+		void begin_blocking()noexcept override;
+
+		/// \brief Called by managed_blocking in a worker thread
+		void end_blocking()noexcept override;
+
+
+		/// \brief Start workers until worker_count_ are not blocked
+		///
+		/// mutex_ must be locked. Does nothing after shutdown_ is set.
+		void start_workers();
+
+		/// \brief The function of all worker threads
+		void run(std::list< std::thread >::iterator self)noexcept;
+
+		/// \brief Busy poll until a task is queued or duration is over
+		void spin(std::chrono::nanoseconds duration)const noexcept;
+
+
+		/// \brief A task with its scheduling data
+		struct queued_task{
+			/// \brief The task
+			executor::task task;
+
+			/// \brief Priority of the scheduling class
+			int priority;
+
+			/// \brief Point in time until the task should be done
+			time_point deadline;
+
+			/// \brief Virtual start time for the fair share
+			std::uint64_t start;
+
+			/// \brief Number of the post() call
+			std::uint64_t sequence;
+		};
+
+		/// \brief Heap order, true if a must run after b
+		static bool runs_after(
+			queued_task const& a,
+			queued_task const& b
+		)noexcept;
+
+		/// \brief Take the task that must run next
+		///
+		/// mutex_ must be locked and tasks_ must not be empty.
+		task pop_task();
+
+		/// \brief A worker thread with its local queue
+		struct worker_slot{
+			/// \brief true while a thread uses the slot
+			bool used = false;
+
+			/// \brief true while the thread waits for a task
+			bool idle = false;
+
+			/// \brief Tasks that prefer this worker in post order
+			std::deque< queued_task > local;
+		};
+
+		/// \brief true if worker self has a task to run
+		///
+		/// mutex_ must be locked.
+		bool has_task(std::size_t self)const noexcept;
+
+		/// \brief Take the task worker self runs next
+		///
+		/// Its local queue first if the task has at least the priority of
+		/// the global queue, then the global queue, then the local queue
+		/// of a busy worker. mutex_ must be locked and has_task(self) must
+		/// be true.
+		task take_task(std::size_t self);
+
+		/// \brief Count of all queued tasks
+		///
+		/// mutex_ must be locked.
+		std::size_t queued()const noexcept{
+			return tasks_.size() + local_count_;
+		}
+
+
+		/// \brief Protects all members
+		mutable std::mutex mutex_;
+
+		/// \brief Signaled on new tasks, shutdown and surplus workers
+		std::condition_variable cv_;
+
+		/// \brief Queued tasks as heap ordered by runs_after()
+		std::vector< queued_task > tasks_;
+
+		/// \brief Worker threads by index
+		std::vector< worker_slot > slots_;
+
+		/// \brief Count of tasks in all local queues
+		std::size_t local_count_ = 0;
+
+		/// \brief Class of tasks posted without class
+		scheduling_class default_class_;
+
+		/// \brief Start time of the last task that was taken from the queue
+		std::uint64_t virtual_time_ = 0;
+
+		/// \brief Count of post() calls
+		std::uint64_t sequence_ = 0;
+
+		/// \brief All worker threads
+		std::list< std::thread > threads_;
+
+		/// \brief Threads that ended and must be joined
+		std::vector< std::list< std::thread >::iterator > exited_;
+
+		/// \brief Target count of not blocked workers
+		std::atomic< std::size_t > worker_count_;
+
+		/// \brief Count of running worker threads
+		std::size_t running_ = 0;
+
+		/// \brief Count of workers inside a managed_blocking
+		std::size_t blocked_ = 0;
+
+		/// \brief Count of workers waiting for a task
+		std::atomic< std::size_t > idle_{0};
+
+		/// \brief Count of queued tasks, readable without mutex_ by spinning
+		///        workers
+		std::atomic< std::size_t > pending_{0};
+
+		/// \brief Maximum count of idle workers that busy poll
+		std::atomic< std::size_t > spinning_worker_count_{0};
+
+		/// \brief Time an idle worker busy polls before it sleeps
+		std::atomic< std::chrono::nanoseconds > spin_duration_{
+			std::chrono::milliseconds(1)};
+
+		/// \brief Count of workers that currently busy poll
+		std::size_t spinning_ = 0;
+
+		/// \brief Lowest count of workers
+		std::atomic< std::size_t > min_worker_count_;
+
+		/// \brief Highest count of workers
+		std::atomic< std::size_t > max_worker_count_;
+
+		/// \brief Time after which an idle worker ends in elastic mode
+		std::chrono::nanoseconds idle_timeout_{std::chrono::seconds(1)};
+
+		/// \brief Highest worker_count_ so far
+		std::size_t peak_worker_count_;
+
+		/// \brief Count of workers added by post()
+		std::size_t grow_count_ = 0;
+
+		/// \brief Count of workers that ended after the idle timeout
+		std::size_t shrink_count_ = 0;
+
+		/// \brief true after the first post()
+		bool started_ = false;
+
+		/// \brief true in the destructor
+		bool shutdown_ = false;
+	};
+
+
+}
+
+
+#endif
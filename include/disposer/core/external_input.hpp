@@ -0,0 +1,68 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__external_input__hpp_INCLUDED_
+#define _disposer__core__external_input__hpp_INCLUDED_
+
+#include "output_name.hpp"
+
+#include <string>
+
+
+namespace disposer{
+
+
+	/// \brief Exec function of a start module that moves an argument of
+	///        chain::exec() to its output
+	///
+	/// Usage:
+	///
+	/// \code
+	/// generate_module("frame input",
+	/// 	module_configure(make("frame"_out, free_type_c< frame >, "…")),
+	/// 	exec_fn(external_input("frame", "frame"_out)));
+	///
+	/// exec_arguments arguments;
+	/// arguments.emplace("frame", std::move(frame));
+	/// chain.exec(std::move(arguments));
+	/// \endcode
+	///
+	/// The argument must have exactly the output type, otherwise the exec
+	/// of the module fails.
+	template < typename OutputName >
+	class external_input{
+	public:
+		/// \brief Constructor
+		external_input(std::string key, OutputName output)
+			: key_(std::move(key))
+			, output_(output) {}
+
+
+		/// \brief Move the argument to the output
+		template < typename ModuleRef >
+		void operator()(ModuleRef& module)const{
+			auto& output = module(output_);
+			using type = typename std::remove_reference_t<
+				decltype(output) >::type;
+			output.push(module.arguments().template take< type >(key_));
+		}
+
+
+	private:
+		/// \brief Key of the argument
+		std::string key_;
+
+		/// \brief Name of the output
+		OutputName output_;
+	};
+
+
+}
+
+
+#endif
@@ -0,0 +1,72 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__external_output__hpp_INCLUDED_
+#define _disposer__core__external_output__hpp_INCLUDED_
+
+#include "input_name.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace disposer{
+
+
+	/// \brief Exec function of a final module that returns its input to the
+	///        caller of chain::exec()
+	///
+	/// Usage:
+	///
+	/// \code
+	/// generate_module("count result",
+	/// 	module_configure(make("count"_in, free_type_c< int >, "…")),
+	/// 	exec_fn(external_output("count", "count"_in)));
+	///
+	/// auto info = chain.exec();
+	/// auto counts = info.results.take< std::vector< int > >("count");
+	/// \endcode
+	///
+	/// The result is a std::vector of all elements of the input in order.
+	/// The elements are moved if the input is the last use of its output.
+	template < typename InputName >
+	class external_output{
+	public:
+		/// \brief Constructor
+		external_output(std::string key, InputName input)
+			: key_(std::move(key))
+			, input_(input) {}
+
+
+		/// \brief Move the input data to the results
+		template < typename ModuleRef >
+		void operator()(ModuleRef& module)const{
+			auto& input = module(input_);
+			using type = typename std::remove_reference_t<
+				decltype(input) >::type;
+
+			// the iterators of values() move the elements
+			auto data = input.values();
+			module.results().emplace(key_,
+				std::vector< type >(data.begin(), data.end()));
+		}
+
+
+	private:
+		/// \brief Key of the result
+		std::string key_;
+
+		/// \brief Name of the input
+		InputName input_;
+	};
+
+
+}
+
+
+#endif
@@ -16,10 +16,25 @@ namespace disposer{
 
 
 	/// \brief Generator for unique ID's
+	///
+	/// With a block size of 1 the ID's are dense and in the order of the
+	/// calls. chain::exec() relies on this for the exec ID's, which
+	/// no_overtaking modules use to keep the exec order.
+	///
+	/// With a greater block size every thread reserves a block of ID's at
+	/// once, so generators shared by many chains don't make all threads
+	/// contend for one counter. The ID's are still unique and increase per
+	/// thread, but they are not dense and not ordered across threads.
+	///
+	/// Every thread caches blocks of up to cache_size generators at once,
+	/// so a thread that alternates between generators keeps its blocks.
 	class id_generator{
 	public:
 		/// \brief Initialize the counter with 0
-		id_generator(): next_id(0){}
+		explicit id_generator(std::size_t block_size = 1)noexcept
+			: block_size_(block_size > 0 ? block_size : 1)
+			, instance_(next_instance()++)
+			, next_id_(0) {}
 
 
 		/// \brief id_generators are not copyable
@@ -37,14 +52,67 @@ namespace disposer{
 
 
 		/// \brief Get the ID and increase the counter
-		std::size_t operator()(){
-			return next_id++;
+		std::size_t operator()()noexcept{
+			if(block_size_ == 1){
+				return next_id_.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			// the blocks of the generators this thread used, a generator
+			// only replaces the block of another one in the same slot
+			thread_local block cache[cache_size];
+			auto& entry = cache[instance_ % cache_size];
+			if(entry.instance != instance_ || entry.next == entry.end){
+				entry.instance = instance_;
+				entry.next = next_id_.fetch_add(
+					block_size_, std::memory_order_relaxed);
+				entry.end = entry.next + block_size_;
+			}
+			return entry.next++;
 		}
 
 
+		/// \brief Count of ID's a thread reserves at once
+		std::size_t block_size()const noexcept{
+			return block_size_;
+		}
+
+
+		/// \brief Count of slots per thread for the blocks of different
+		///        generators
+		static constexpr std::size_t cache_size = 16;
+
+
 	private:
-		/// \brief The counter
-		std::atomic< std::size_t > next_id;
+		/// \brief Reserved ID's of a thread
+		struct block{
+			/// \brief Generator that reserved the block, 0 if none
+			std::size_t instance = 0;
+
+			/// \brief Next free ID
+			std::size_t next = 0;
+
+			/// \brief End of the block
+			std::size_t end = 0;
+		};
+
+		/// \brief Source of unique generator numbers
+		///
+		/// A generator at the address of a destroyed one must not use its
+		/// blocks.
+		static std::atomic< std::size_t >& next_instance()noexcept{
+			static std::atomic< std::size_t > instance{1};
+			return instance;
+		}
+
+
+		/// \brief Count of ID's a thread reserves at once
+		std::size_t const block_size_;
+
+		/// \brief Unique number of this generator
+		std::size_t const instance_;
+
+		/// \brief The counter, on its own cache line
+		alignas(64) std::atomic< std::size_t > next_id_;
 	};
 
 
@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__input_stream__hpp_INCLUDED_
+#define _disposer__core__input_stream__hpp_INCLUDED_
+
+#include "exec_output.hpp"
+
+#include <iterator>
+
+
+namespace disposer{
+
+
+	/// \brief Element wise access to the data of an exec_input
+	///
+	/// If the connected output is a stream, the elements are received while
+	/// the producing module is still running. Otherwise the elements are
+	/// taken from the finished output.
+	///
+	/// Usage: for(auto&& value: ref("name"_in).stream()){ … }
+	template < typename T >
+	class input_stream{
+	public:
+		/// \brief Single pass iterator over the elements
+		class iterator{
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+
+			/// \brief End iterator
+			iterator()noexcept
+				: stream_(nullptr) {}
+
+			/// \brief Begin iterator, fetches the first element
+			explicit iterator(input_stream& stream)
+				: stream_(&stream)
+			{
+				++*this;
+			}
+
+
+			/// \brief Reference to the current element
+			T& operator*()const noexcept{
+				return *stream_->value_;
+			}
+
+			/// \brief Pointer to the current element
+			T* operator->()const noexcept{
+				return &*stream_->value_;
+			}
+
+			/// \brief Fetch the next element
+			iterator& operator++(){
+				stream_->value_ = stream_->next();
+				if(!stream_->value_) stream_ = nullptr;
+				return *this;
+			}
+
+
+			/// \brief Equal if both are end iterators or refer to the same
+			///        stream
+			bool operator==(iterator const& other)const noexcept{
+				return stream_ == other.stream_;
+			}
+
+			/// \brief Not equal
+			bool operator!=(iterator const& other)const noexcept{
+				return !(*this == other);
+			}
+
+
+		private:
+			/// \brief The stream or nullptr for the end iterator
+			input_stream* stream_;
+		};
+
+
+		/// \brief Constructor
+		input_stream(unnamed_exec_output< T >& output)noexcept
+			: output_(output)
+			, cursor_(0) {}
+
+		/// \brief input_stream is nighter copy nor movable
+		input_stream(input_stream const&) = delete;
+
+		/// \brief input_stream is nighter copy- nor move- assignable
+		input_stream& operator=(input_stream const&) = delete;
+
+
+		/// \brief Get the next element or an empty optional at the end
+		///
+		/// Throws stream_aborted if the producing module failed.
+		std::optional< T > next(){
+			return output_.pop(cursor_);
+		}
+
+
+		/// \brief Fetch the first element and return an iterator to it
+		iterator begin(){
+			return iterator(*this);
+		}
+
+		/// \brief The end iterator
+		iterator end()noexcept{
+			return iterator();
+		}
+
+
+	private:
+		/// \brief The connected output
+		unnamed_exec_output< T >& output_;
+
+		/// \brief Position of the next element in non stream outputs
+		std::size_t cursor_;
+
+		/// \brief Current element while iterating
+		std::optional< T > value_;
+	};
+
+
+}
+
+
+#endif
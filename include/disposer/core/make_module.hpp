@@ -311,7 +311,7 @@ namespace disposer{
 			typename ... Config,
 			typename ... IOPs >
 		std::unique_ptr< module_base > exec_make_output(
-			output_maker< Name, DimensionReferrer > const&,
+			output_maker< Name, DimensionReferrer > const& maker,
 			dimension_list< Ds ... > dims,
 			detail::config_queue< Offset, Config ... > const configs,
 			iops_ref< IOPs ... >&& iops
@@ -327,7 +327,8 @@ namespace disposer{
 				auto const use_count = get_use_count(data.outputs,
 					detail::to_std_string_view(Name{}));
 
-				output< Name, type > output{use_count};
+				output< Name, type > output{
+					use_count, maker.stream_capacity, maker.spill_threshold};
 
 				return make_module(dims, configs,
 					iops_ref(std::move(output), std::move(iops)));
@@ -26,6 +26,36 @@
 namespace disposer{
 
 
+	/// \brief Declares an output as stream
+	///
+	/// The elements of a stream output are passed to the connected input
+	/// while the producing module is still running. The consuming module is
+	/// started together with the producing one and reads the elements via
+	/// its inputs stream() function. At most capacity elements are buffered,
+	/// the producer blocks on push if the buffer is full. A capacity of 0
+	/// declares a normal output.
+	struct output_stream{
+		/// \brief Count of elements the stream may buffer
+		std::size_t capacity;
+	};
+
+
+	/// \brief Declares an output as spillable
+	///
+	/// After the producing module finished, the data of a spillable output
+	/// is moved into a memory-mapped temporary file if it holds at least
+	/// threshold bytes or if the chain or system is over its memory budget.
+	/// The connected inputs read the data from the mapping. This keeps large
+	/// data out of RAM while it waits for slow consumers. Only outputs of
+	/// trivially copyable types except bool can be spilled, creating a
+	/// module throws if the setting is used for another type. Streams are
+	/// not spilled.
+	struct output_spill{
+		/// \brief Size in bytes from which the data is spilled
+		std::size_t threshold;
+	};
+
+
 	/// \brief Provid types for constructing an output
 	template <
 		typename Name,
@@ -49,7 +79,14 @@ namespace disposer{
 		std::string help_text_fn(dimension_list< DTs ... >)const{
 			std::ostringstream help;
 			help << "    * output: "
-				<< detail::to_std_string_view(name) << "\n";
+				<< detail::to_std_string_view(name);
+			if(stream_capacity > 0){
+				help << " (stream, capacity " << stream_capacity << ")";
+			}
+			if(spill_threshold > 0){
+				help << " (spill from " << spill_threshold << " bytes)";
+			}
+			help << "\n";
 			help << help_text << "\n";
 			help << wrapped_type_ref_text(
 				DimensionReferrer{}, dimension_list< DTs ... >{});
@@ -59,6 +96,14 @@ namespace disposer{
 
 		/// \brief User defined help text
 		std::string const help_text;
+
+		/// \brief Count of elements the stream may buffer, 0 if the output
+		///        is not a stream
+		std::size_t const stream_capacity = 0;
+
+		/// \brief Size in bytes from which the data is spilled, 0 if the
+		///        output is not spillable
+		std::size_t const spill_threshold = 0;
 	};
 
 
@@ -80,6 +125,47 @@ namespace disposer{
 			};
 	}
 
+	/// \brief Creates a \ref output_maker object for a stream output
+	template <
+		char ... C,
+		template < typename ... > typename Template,
+		std::size_t ... D >
+	auto make(
+		output_name< C ... > const&,
+		dimension_referrer< Template, D ... > const&,
+		std::string const& description,
+		output_stream const& stream
+	){
+		return output_maker<
+			output_name< C ... >,
+			dimension_referrer< Template, D ... > >{
+				"      * " +
+				boost::replace_all_copy(description, "\n", "\n        "),
+				stream.capacity
+			};
+	}
+
+	/// \brief Creates a \ref output_maker object for a spillable output
+	template <
+		char ... C,
+		template < typename ... > typename Template,
+		std::size_t ... D >
+	auto make(
+		output_name< C ... > const&,
+		dimension_referrer< Template, D ... > const&,
+		std::string const& description,
+		output_spill const& spill
+	){
+		return output_maker<
+			output_name< C ... >,
+			dimension_referrer< Template, D ... > >{
+				"      * " +
+				boost::replace_all_copy(description, "\n", "\n        "),
+				0,
+				spill.threshold
+			};
+	}
+
 
 	inline std::size_t get_use_count(
 		output_list const& outputs,
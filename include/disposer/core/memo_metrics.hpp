@@ -0,0 +1,64 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__memo_metrics__hpp_INCLUDED_
+#define _disposer__core__memo_metrics__hpp_INCLUDED_
+
+#include <cstddef>
+#include <string>
+
+
+namespace disposer{
+
+
+	/// \brief Snapshot of the cache of a memoized module
+	struct memo_metrics{
+		/// \brief Execs that reused cached outputs
+		std::size_t hits;
+
+		/// \brief Execs that called the exec function
+		std::size_t misses;
+
+		/// \brief Count of cached input combinations
+		std::size_t size;
+
+		/// \brief Maximum count of cached input combinations
+		std::size_t capacity;
+
+		/// \brief Bytes of the cached inputs and outputs
+		std::size_t bytes;
+
+
+		/// \brief Share of hits in all execs, 0 if there was none
+		double hit_rate()const noexcept{
+			auto const count = hits + misses;
+			return count > 0 ? static_cast< double >(hits) / count : 0.;
+		}
+	};
+
+
+	/// \brief Cache metrics of a module in a chain
+	struct module_memo_metrics{
+		/// \brief Index of the replica of the chain
+		std::size_t replica;
+
+		/// \brief Position of the module in the chain, starting with 1
+		std::size_t number;
+
+		/// \brief Name of the module type
+		std::string type_name;
+
+		/// \brief The cache metrics
+		memo_metrics metrics;
+	};
+
+
+}
+
+
+#endif
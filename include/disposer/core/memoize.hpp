@@ -0,0 +1,383 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__memoize__hpp_INCLUDED_
+#define _disposer__core__memoize__hpp_INCLUDED_
+
+#include "memo_metrics.hpp"
+#include "memory_usage.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <boost/hana/at.hpp>
+#include <boost/hana/fold_left.hpp>
+#include <boost/hana/for_each.hpp>
+#include <boost/hana/unpack.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include <list>
+
+
+namespace disposer{
+
+
+	namespace hana = boost::hana;
+
+
+	/// \brief Hashes values with std::hash
+	struct std_hasher{
+		template < typename T >
+		std::size_t operator()(T const& value)const{
+			return std::hash< T >()(value);
+		}
+	};
+
+
+	/// \brief Settings of the output cache of a \ref pure module
+	///
+	/// Usage: exec_fn(pure([](auto module){ … }, memoize(16)))
+	///
+	/// Hasher is called with every input element and must accept all input
+	/// types of the module. The input types must be equality comparable,
+	/// the input and output types copyable.
+	template < typename Hasher = std_hasher >
+	struct memoize{
+		/// \brief Constructor
+		constexpr explicit memoize(
+			std::size_t const capacity,
+			Hasher hasher = Hasher()
+		)
+			: capacity(capacity > 0 ? capacity : 1)
+			, hasher(std::move(hasher)) {}
+
+		/// \brief Maximum count of cached input combinations
+		std::size_t capacity;
+
+		/// \brief Hash function for input elements
+		Hasher hasher;
+	};
+
+
+	/// \brief Output cache of a memoized module
+	///
+	/// Keeps the outputs of the last capacity distinct input combinations
+	/// and evicts the least recently used one. On a hit the cached outputs
+	/// are copied to the outputs instead of calling the exec function. The
+	/// lookup is linear, the cache is meant for a few entries.
+	///
+	/// The cached copies are accounted as cached data in the memory_usage
+	/// of the outputs. While it is over its budget after an insert, the
+	/// least recently used entries are evicted. clear() releases all
+	/// entries, the module calls it when it is disabled.
+	///
+	/// Modules with stream outputs always call the exec function, a stream
+	/// is consumed while it is produced. Chains don't connect stream inputs
+	/// to memoized modules, they pass the data as a whole. Unconnected
+	/// optional inputs are skipped.
+	template < typename Hasher >
+	class memo_cache{
+	public:
+		/// \brief Constructor
+		explicit memo_cache(memoize< Hasher > const& config)
+			: config_(config) {}
+
+
+		/// \brief Reuse cached outputs or call fn and cache its outputs
+		template < typename ModuleRef, typename Fn >
+		void exec(ModuleRef& module, Fn& fn){
+			auto& inputs = module.inputs();
+			auto& outputs = module.outputs();
+
+			auto const is_stream = [](bool const stream, auto const& list){
+					return stream || list.is_stream();
+				};
+			if(hana::fold_left(outputs, false, is_stream)
+				|| hana::fold_left(inputs, false, is_stream)
+			){
+				call(module, fn);
+				return;
+			}
+
+			using inputs_type = decltype(copy(inputs));
+			using outputs_type = decltype(copy(outputs));
+
+			auto const hash = hash_of(inputs);
+
+			std::shared_ptr< void const > hit;
+			{
+				std::lock_guard lock(mutex_);
+				for(auto iter = entries_.begin(); iter != entries_.end();
+					++iter
+				){
+					if(iter->hash != hash || !equal(inputs,
+						*static_cast< inputs_type const* >(iter->inputs.get()))
+					) continue;
+
+					entries_.splice(entries_.begin(), entries_, iter);
+					hit = iter->outputs;
+					break;
+				}
+			}
+
+			if(hit){
+				++hits_;
+				replay(outputs,
+					*static_cast< outputs_type const* >(hit.get()));
+				return;
+			}
+
+			++misses_;
+
+			// fn may move the data out of the inputs
+			auto inputs_copy =
+				std::make_shared< inputs_type const >(copy(inputs));
+
+			call(module, fn);
+
+			// the data of appenders is merged into the outputs
+			hana::for_each(outputs, [](auto& output){
+					output.merge_chunks();
+				});
+
+			auto outputs_copy =
+				std::make_shared< outputs_type const >(copy(outputs));
+			auto const bytes = bytes_of(*inputs_copy) + bytes_of(*outputs_copy);
+			auto const memory = hana::fold_left(outputs,
+				static_cast< memory_usage* >(nullptr),
+				[](memory_usage* const memory, auto const& output){
+					return memory ? memory : output.memory();
+				});
+
+			std::lock_guard lock(mutex_);
+
+			// a concurrent miss may have cached the same inputs meanwhile
+			auto const cached = std::find_if(entries_.begin(), entries_.end(),
+				[hash, &inputs_copy](entry const& value){
+					return value.hash == hash && *inputs_copy
+						== *static_cast< inputs_type const* >(
+							value.inputs.get());
+				});
+			if(cached != entries_.end()){
+				entries_.splice(entries_.begin(), entries_, cached);
+				return;
+			}
+
+			if(!memory_) memory_ = memory;
+			entries_.push_front(entry{hash, std::move(inputs_copy),
+				std::move(outputs_copy), bytes});
+			bytes_ += bytes;
+			if(memory_) memory_->add_cached(bytes);
+
+			while(!entries_.empty() && (entries_.size() > config_.capacity
+				|| (memory_ && memory_->over_budget()))
+			){
+				evict();
+			}
+		}
+
+
+		/// \brief Remove all entries
+		void clear()noexcept{
+			std::lock_guard lock(mutex_);
+			while(!entries_.empty()) evict();
+			memory_ = nullptr;
+		}
+
+
+		/// \brief Snapshot of the cache state
+		memo_metrics metrics()const{
+			std::lock_guard lock(mutex_);
+			return {hits_, misses_, entries_.size(), config_.capacity, bytes_};
+		}
+
+
+	private:
+		/// \brief Cached outputs of an input combination
+		struct entry{
+			/// \brief Hash of the inputs
+			std::size_t hash;
+
+			/// \brief Copy of the inputs, std::tuple of std::vector's
+			std::shared_ptr< void const > inputs;
+
+			/// \brief Copy of the outputs, std::tuple of std::vector's
+			std::shared_ptr< void const > outputs;
+
+			/// \brief Accounted bytes of both copies
+			std::size_t bytes;
+		};
+
+
+		/// \brief Remove the least recently used entry, mutex_ must be
+		///        locked
+		void evict()noexcept{
+			auto const bytes = entries_.back().bytes;
+			entries_.pop_back();
+			bytes_ -= bytes;
+			if(memory_) memory_->sub_cached(bytes);
+		}
+
+		/// \brief Accounted bytes of a copy of inputs or outputs
+		template < typename Copy >
+		static std::size_t bytes_of(Copy const& copy){
+			return std::apply([](auto const& ... values){
+					return (std::size_t(0) + ... + bytes_of_vector(values));
+				}, copy);
+		}
+
+		/// \brief Accounted bytes of the elements of a vector
+		template < typename T >
+		static std::size_t bytes_of_vector(std::vector< T > const& values){
+			std::size_t bytes = 0;
+			for(auto const& value: values) bytes += memory_size< T >{}(value);
+			return bytes;
+		}
+
+
+		/// \brief Call fn with or without the module
+		template < typename ModuleRef, typename Fn >
+		static void call(ModuleRef& module, Fn& fn){
+			if constexpr(std::is_invocable_v< Fn&, ModuleRef& >){
+				std::invoke(fn, module);
+			}else{
+				(void)module; // silence unused warning
+				std::invoke(fn);
+			}
+		}
+
+		/// \brief Copy the data of all inputs or outputs
+		template < typename List >
+		static auto copy(List& list){
+			return hana::unpack(list, [](auto& ... element){
+					return std::make_tuple(to_vector(element) ...);
+				});
+		}
+
+		/// \brief Copy the data of an input or output to a std::vector
+		///
+		/// Empty for unconnected inputs.
+		template < typename Element >
+		static auto to_vector(Element& element){
+			using type = typename Element::type;
+			if(!is_connected(element)) return std::vector< type >();
+			auto const data = element.references();
+			return std::vector< type >(data.begin(), data.end());
+		}
+
+		/// \brief false if element is an unconnected optional input
+		template < typename Element >
+		static bool is_connected(Element& element){
+			if constexpr(has_is_required< Element >::value){
+				if constexpr(!Element::is_required){
+					return element.is_connected();
+				}
+			}
+			(void)element; // silence unused warning
+			return true;
+		}
+
+		/// \brief true if Element is an input
+		template < typename Element, typename = void >
+		struct has_is_required: std::false_type{};
+
+		template < typename Element >
+		struct has_is_required< Element,
+			std::void_t< decltype(Element::is_required) > >: std::true_type{};
+
+		/// \brief Hash of all input elements
+		template < typename Inputs >
+		std::size_t hash_of(Inputs& inputs)const{
+			std::size_t seed = 0;
+			hana::for_each(inputs, [this, &seed](auto& input){
+					if(!is_connected(input)) return;
+					auto const data = input.references();
+					boost::hash_combine(seed, data.size());
+					for(auto const& value: data){
+						boost::hash_combine(seed, config_.hasher(value));
+					}
+				});
+			return seed;
+		}
+
+		/// \brief true if the inputs equal the cached copy
+		template < typename Inputs, typename Copy >
+		static bool equal(Inputs& inputs, Copy const& copy){
+			return equal(inputs, copy, std::make_index_sequence<
+				std::tuple_size_v< Copy > >());
+		}
+
+		template < typename Inputs, typename Copy, std::size_t ... I >
+		static bool equal(
+			Inputs& inputs,
+			Copy const& copy,
+			std::index_sequence< I ... >
+		){
+			auto const equal_input = [](auto& input, auto const& values){
+					if(!is_connected(input)) return true;
+					auto const data = input.references();
+					return std::equal(data.begin(), data.end(),
+						values.begin(), values.end());
+				};
+			return (equal_input(hana::at_c< I >(inputs), std::get< I >(copy))
+				&& ...);
+		}
+
+		/// \brief Push copies of the cached data to the outputs
+		template < typename Outputs, typename Copy >
+		static void replay(Outputs& outputs, Copy const& copy){
+			replay(outputs, copy, std::make_index_sequence<
+				std::tuple_size_v< Copy > >());
+		}
+
+		template < typename Outputs, typename Copy, std::size_t ... I >
+		static void replay(
+			Outputs& outputs,
+			Copy const& copy,
+			std::index_sequence< I ... >
+		){
+			auto const replay_output = [](auto& output, auto const& values){
+					for(auto const& value: values) output.push(value);
+				};
+			(replay_output(hana::at_c< I >(outputs), std::get< I >(copy)), ...);
+		}
+
+
+		/// \brief The settings
+		memoize< Hasher > const config_;
+
+		/// \brief Cached outputs, most recently used first
+		std::list< entry > entries_;
+
+		/// \brief Sum of the bytes of all entries
+		std::size_t bytes_ = 0;
+
+		/// \brief Object of the chain where the entries are accounted
+		memory_usage* memory_ = nullptr;
+
+		/// \brief Protects entries_, bytes_ and memory_
+		mutable std::mutex mutex_;
+
+		/// \brief Count of execs that reused cached outputs
+		std::atomic< std::size_t > hits_{0};
+
+		/// \brief Count of execs that called the exec function
+		std::atomic< std::size_t > misses_{0};
+	};
+
+
+}
+
+
+#endif
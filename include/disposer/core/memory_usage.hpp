@@ -0,0 +1,197 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__memory_usage__hpp_INCLUDED_
+#define _disposer__core__memory_usage__hpp_INCLUDED_
+
+#include "../tool/managed_blocking.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <type_traits>
+
+
+namespace disposer{
+
+
+	/// \brief Count of bytes held by an output data element
+	///
+	/// If T has a member function memory_size() its result is used,
+	/// otherwise sizeof(T). Specialize this struct for types that own
+	/// additional memory without a member function.
+	template < typename T, typename = void >
+	struct memory_size{
+		constexpr std::size_t operator()(T const&)const noexcept{
+			return sizeof(T);
+		}
+	};
+
+	template < typename T >
+	struct memory_size< T, std::void_t<
+		decltype(std::declval< T const& >().memory_size()) > >
+	{
+		std::size_t operator()(T const& value)const{
+			return value.memory_size();
+		}
+	};
+
+
+	/// \brief Bytes held by in-flight output data of a chain or the system
+	///
+	/// Every change is forwarded to the parent object, so the system object
+	/// contains the sum of all chains.
+	class memory_usage{
+	public:
+		/// \brief Constructor
+		memory_usage(memory_usage* parent = nullptr)noexcept
+			: parent_(parent)
+			, current_(0)
+			, cached_(0)
+			, peak_(0)
+			, budget_(0) {}
+
+		/// \brief Not copyable
+		memory_usage(memory_usage const&) = delete;
+
+		/// \brief Not copy-assignable
+		memory_usage& operator=(memory_usage const&) = delete;
+
+
+		/// \brief Bytes currently held
+		std::size_t current()const noexcept{
+			return current_;
+		}
+
+		/// \brief Part of current() held by caches
+		std::size_t cached()const noexcept{
+			return cached_;
+		}
+
+		/// \brief Highest value of current() so far
+		std::size_t peak()const noexcept{
+			return peak_;
+		}
+
+		/// \brief Maximum bytes before new execs are delayed, 0 if unlimited
+		std::size_t budget()const noexcept{
+			return budget_;
+		}
+
+
+		/// \brief Set the maximum bytes before new execs are delayed
+		///
+		/// 0 disables the limit.
+		void set_budget(std::size_t const bytes)noexcept{
+			{
+				std::lock_guard lock(mutex_);
+				budget_ = bytes;
+			}
+			cv_.notify_all();
+		}
+
+
+		/// \brief Account new data
+		void add(std::size_t const bytes)noexcept{
+			auto const value = current_ += bytes;
+			auto peak = peak_.load();
+			while(value > peak && !peak_.compare_exchange_weak(peak, value));
+			if(parent_) parent_->add(bytes);
+		}
+
+		/// \brief Account released data
+		void sub(std::size_t const bytes)noexcept{
+			current_ -= bytes;
+			if(budget_ > 0){
+				// lock to avoid a lost wakeup in wait_for_budget
+				{ std::lock_guard lock(mutex_); }
+				cv_.notify_all();
+			}
+			if(parent_) parent_->sub(bytes);
+		}
+
+
+		/// \brief Account data of a cache
+		///
+		/// It counts to current() and over_budget(), but new execs are not
+		/// delayed for it. The cache releases it if it is over budget.
+		void add_cached(std::size_t const bytes)noexcept{
+			add(bytes);
+			for(auto usage = this; usage; usage = usage->parent_){
+				usage->cached_ += bytes;
+			}
+		}
+
+		/// \brief Account released data of a cache
+		void sub_cached(std::size_t const bytes)noexcept{
+			for(auto usage = this; usage; usage = usage->parent_){
+				usage->cached_ -= bytes;
+			}
+			sub(bytes);
+		}
+
+
+		/// \brief true if this object or one of its parents is over its
+		///        budget
+		bool over_budget()const noexcept{
+			if(budget_ > 0 && current_ >= budget_) return true;
+			return parent_ && parent_->over_budget();
+		}
+
+
+		/// \brief Block while this object or one of its parents is over
+		///        its budget without the cached data
+		void wait_for_budget()noexcept{
+			if(parent_) parent_->wait_for_budget();
+			if(budget_ == 0) return;
+
+			std::unique_lock lock(mutex_);
+			auto const ready = [this]{
+					// the counters are read one after the other
+					auto const cached = cached_.load();
+					auto const current = current_.load();
+					return budget_ == 0
+						|| (current > cached ? current - cached : 0) < budget_;
+				};
+			if(!ready()){
+				// on an executor worker, the consumers that release the
+				// memory may wait in its queue
+				managed_blocking blocking;
+				cv_.wait(lock, ready);
+			}
+		}
+
+
+	private:
+		/// \brief Object of the chain or system or nullptr
+		memory_usage* const parent_;
+
+		/// \brief Bytes currently held
+		std::atomic< std::size_t > current_;
+
+		/// \brief Part of current_ held by caches
+		std::atomic< std::size_t > cached_;
+
+		/// \brief Highest value of current_
+		std::atomic< std::size_t > peak_;
+
+		/// \brief Maximum bytes before new execs are delayed
+		std::atomic< std::size_t > budget_;
+
+		/// \brief Protects waiting for the budget
+		std::mutex mutex_;
+
+		/// \brief Signaled when bytes are released or the budget changed
+		std::condition_variable cv_;
+	};
+
+
+}
+
+
+#endif
@@ -15,6 +15,8 @@
 #include "module_init_fn.hpp"
 #include "exec_fn.hpp"
 
+#include "../tool/managed_blocking.hpp"
+
 #include <mutex>
 #include <condition_variable>
 
@@ -36,6 +38,9 @@ namespace disposer{
 
 		void wait(std::size_t const exec_id)noexcept{
 			std::unique_lock lock(mutex_);
+			if(next_exec_id_ == exec_id) return;
+
+			managed_blocking blocking;
 			cv_.wait(lock,
 				[this, exec_id]{ return next_exec_id_ == exec_id; });
 		}
@@ -160,13 +165,25 @@ namespace disposer{
 		/// \brief Calls the exec_fn
 		bool exec(exec_module_type& exec_module)noexcept{
 			auto const id = exec_module.id();
-			module_ref ref{exec_module, state_.object()};
+			auto const details = exec_module.exec_details();
+			auto const wait_start = details && !CanRunConcurrent
+				? std::chrono::steady_clock::now()
+				: std::chrono::steady_clock::time_point();
 			concurrency_manager_guard< concurrency_manager< CanRunConcurrent > >
 				manager(*this, exec_module.exec_id());
+			if(details && !CanRunConcurrent){
+				details->wait = std::chrono::steady_clock::now() - wait_start;
+			}
 			return logsys::exception_catching_log(
 				[this, id](logsys::stdlogb& os){
 					os << "id(" << id << ") " << this->log_prefix() << "exec";
-				}, [this, &ref]{ exec_fn_(ref); });
+				}, [this, &exec_module]{
+					// per worker state objects are taken from a pool
+					auto const state = state_.acquire();
+					module_ref ref{exec_module, state.get(),
+						module_state_type::is_per_worker};
+					exec_fn_(ref);
+				});
 		}
 
 
@@ -179,7 +196,10 @@ namespace disposer{
 		}
 
 		/// \brief Disables the module for exec calls
+		///
+		/// Releases the output cache of a memoized module.
 		virtual void disable()noexcept override{
+			if constexpr(is_memoized_v< ExecFn >) exec_fn_.fn().clear();
 			state_.disable();
 		}
 
@@ -216,6 +236,21 @@ namespace disposer{
 		}
 
 
+		/// \brief true if the exec function is marked as \ref pure
+		virtual bool is_pure()const noexcept override{
+			return is_pure_v< ExecFn >;
+		}
+
+		/// \brief Metrics of the output cache if the module is memoized
+		virtual std::optional< memo_metrics > memoization()const override{
+			if constexpr(is_memoized_v< ExecFn >){
+				return exec_fn_.fn().metrics();
+			}else{
+				return std::nullopt;
+			}
+		}
+
+
 		/// \brief hana::tuple of parameters
 		Parameters const& parameters()const{
 			return data_.parameters;
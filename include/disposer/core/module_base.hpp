@@ -13,11 +13,14 @@
 #include "output_map_type.hpp"
 #include "output_base.hpp"
 #include "input_base.hpp"
+#include "memo_metrics.hpp"
 
 #include "../tool/module_ptr.hpp"
 
 #include <logsys/log_base.hpp>
 
+#include <optional>
+
 
 namespace disposer{
 
@@ -73,6 +76,18 @@ namespace disposer{
 		virtual output_name_to_ptr_type output_name_to_ptr() = 0;
 
 
+		/// \brief true if the exec function has no side effects
+		///
+		/// See \ref pure.
+		virtual bool is_pure()const noexcept = 0;
+
+		/// \brief Metrics of the output cache of a memoized module, empty
+		///        for other modules
+		///
+		/// See \ref memoize.
+		virtual std::optional< memo_metrics > memoization()const = 0;
+
+
 		/// \brief Name of the process chain in config file section 'chain'
 		std::string const chain;
 
@@ -11,6 +11,12 @@
 
 #include "module_data.hpp"
 
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <mutex>
+
 
 namespace disposer{
 
@@ -145,10 +151,51 @@ namespace disposer{
 	module_init_fn() -> module_init_fn< void >;
 
 
+	/// \brief Marks a module state function to create one state object per
+	///        worker
+	///
+	/// Usage: module_init_fn(per_worker_state([](auto const& module){ … }))
+	///
+	/// For modules that can run concurrently but whose state type is not
+	/// thread safe. Every running exec gets an own state object, so
+	/// state() needs no synchronization.
+	template < typename Fn >
+	class per_worker_state{
+	public:
+		constexpr explicit per_worker_state(Fn const& fn)
+			noexcept(std::is_nothrow_copy_constructible_v< Fn >)
+			: fn_(fn) {}
+
+		constexpr explicit per_worker_state(Fn&& fn)
+			noexcept(std::is_nothrow_move_constructible_v< Fn >)
+			: fn_(std::move(fn)) {}
+
+		/// \brief Calls the function with the same arguments
+		template < typename ... Ref >
+		auto operator()(Ref&& ... ref)const
+			-> std::invoke_result_t< Fn const, Ref ... >
+		{
+			return std::invoke(fn_, static_cast< Ref&& >(ref) ...);
+		}
+
+	private:
+		Fn fn_;
+	};
+
+
+	/// \brief Deleter of state pointers that don't own the state object
+	struct no_state_release{
+		constexpr void operator()(void const*)const noexcept{}
+	};
+
+
 	/// \brief Holds the user defined state object of a module
 	template < typename StateType, typename ModuleInitFn >
 	class module_state{
 	public:
+		/// \brief All execs share the state object
+		static constexpr bool is_per_worker = false;
+
 		/// \brief Constructor
 		module_state(
 			module_init_fn< ModuleInitFn > const& module_init_fn
@@ -185,6 +232,11 @@ namespace disposer{
 			return &*state_;
 		}
 
+		/// \brief Get pointer to state object for the duration of an exec
+		std::unique_ptr< StateType, no_state_release > acquire()noexcept{
+			return std::unique_ptr< StateType, no_state_release >(object());
+		}
+
 
 	private:
 		/// \brief The function object that is called in enable()
@@ -195,6 +247,116 @@ namespace disposer{
 	};
 
 
+	/// \brief Holds one user defined state object per running exec
+	///
+	/// enable() creates the first state object, so errors of the state
+	/// function are reported on enable. If more execs run at the same time,
+	/// additional state objects are created on demand. This way the pool
+	/// grows to the count of workers that actually run the module at once,
+	/// e.g. only one for no_overtaking modules.
+	template < typename StateType, typename Fn >
+	class module_state< StateType, per_worker_state< Fn > >{
+	public:
+		/// \brief Every running exec has an own state object
+		static constexpr bool is_per_worker = true;
+
+		/// \brief Returns the state object to the pool
+		struct give_back{
+			module_state* pool;
+
+			void operator()(StateType* object)const noexcept{
+				pool->release(object);
+			}
+		};
+
+
+		/// \brief Constructor
+		module_state(
+			module_init_fn< per_worker_state< Fn > > const& module_init_fn
+		)noexcept
+			: module_init_fn_(module_init_fn) {}
+
+		/// \brief Enables the module for exec calls
+		///
+		/// Build the users state objects.
+		template <
+			typename TypeList,
+			typename Inputs,
+			typename Outputs,
+			typename Parameters,
+			typename ComponentRef >
+		void enable(
+			module_data< TypeList, Inputs, Outputs, Parameters > const& data,
+			optional_component< ComponentRef > component,
+			std::string&& log_prefix
+		){
+			make_ = [this, &data, component, log_prefix]{
+					return std::make_unique< StateType >(
+						module_init_fn_(module_init_ref< TypeList,
+							Inputs, Outputs, Parameters, ComponentRef >(
+								data, std::string(log_prefix), component)));
+				};
+
+			auto object = make_();
+
+			std::lock_guard lock(mutex_);
+			free_.clear();
+			free_.push_back(std::move(object));
+		}
+
+		/// \brief Disables the module for exec calls
+		void disable()noexcept{
+			std::lock_guard lock(mutex_);
+			free_.clear();
+			make_ = nullptr;
+		}
+
+		/// \brief Take a free state object for the duration of an exec
+		///
+		/// The most recently returned object is used first, because its
+		/// memory is most likely still in a cache.
+		std::unique_ptr< StateType, give_back > acquire(){
+			std::unique_lock lock(mutex_);
+			if(free_.empty()){
+				lock.unlock();
+				return std::unique_ptr< StateType, give_back >(
+					make_().release(), give_back{this});
+			}
+
+			auto object = std::move(free_.back());
+			free_.pop_back();
+			return std::unique_ptr< StateType, give_back >(
+				object.release(), give_back{this});
+		}
+
+
+	private:
+		/// \brief Return a state object to the pool
+		void release(StateType* object)noexcept{
+			std::unique_ptr< StateType > owner(object);
+			std::lock_guard lock(mutex_);
+			try{
+				free_.push_back(std::move(owner));
+			}catch(...){
+				// the object is destroyed and recreated on demand
+			}
+		}
+
+
+		/// \brief The function object that is called in enable()
+		module_init_fn< per_worker_state< Fn > > module_init_fn_;
+
+		/// \brief Creates a new state object while the module is enabled
+		std::function< std::unique_ptr< StateType >() > make_;
+
+		/// \brief State objects not used by a running exec
+		std::vector< std::unique_ptr< StateType > > free_;
+
+		/// \brief Protects free_
+		std::mutex mutex_;
+	};
+
+
 	/// \brief Specialization for stateless modules
 	template <>
 	class module_state< void, void >{
@@ -205,6 +367,9 @@ namespace disposer{
 		/// \brief Constructor
 		module_state(module_init_fn< void > const&)noexcept{}
 
+		/// \brief Module is stateless
+		static constexpr bool is_per_worker = false;
+
 		/// \brief Module is stateless, do nothing
 		template <
 			typename TypeList,
@@ -223,6 +388,11 @@ namespace disposer{
 
 		/// \brief Module is stateless, return nullptr
 		void* object()noexcept{ return nullptr; }
+
+		/// \brief Module is stateless, return nullptr
+		std::unique_ptr< void, no_state_release > acquire()noexcept{
+			return std::unique_ptr< void, no_state_release >();
+		}
 	};
 
 
@@ -14,11 +14,18 @@
 #include "output_name.hpp"
 #include "parameter_name.hpp"
 #include "exec_module.hpp"
+#include "parallel.hpp"
 
 #include "../tool/false_c.hpp"
 
 #include <logsys/log_ref.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <vector>
+#include <mutex>
+
 
 namespace disposer{
 
@@ -37,6 +44,9 @@ namespace disposer{
 	{
 	public:
 		/// \brief Constructor
+		///
+		/// If exclusive_state is true, the state object belongs to the
+		/// calling thread.
 		template <
 			typename Inputs,
 			typename Outputs,
@@ -46,12 +56,15 @@ namespace disposer{
 		module_ref(
 			exec_module< TypeList, Inputs, Outputs, Parameters,
 				ModuleInitFn, ExecFn, CanRunConcurrent, Component >& module,
-			State* state
+			State* state,
+			bool const exclusive_state = false
 		)noexcept
 			: optional_component< Component >(module.component())
 			, logsys::log_ref(module)
 			, module_(module)
 			, state_(state)
+			, state_owner_(exclusive_state
+				? std::this_thread::get_id() : std::thread::id())
 			, inputs_(module.inputs())
 			, outputs_(module.outputs())
 			, parameters_(module.parameters()) {}
@@ -71,6 +84,17 @@ namespace disposer{
 			return get(*this, name);
 		}
 
+		/// \brief hana::tuple of all exec_inputs
+		ExecInputs& inputs()const noexcept{
+			return inputs_;
+		}
+
+		/// \brief hana::tuple of all exec_outputs
+		ExecOutputs& outputs()const noexcept{
+			return outputs_;
+		}
+
+
 		/// \brief Get type by dimension index
 		template < std::size_t DI >
 		static constexpr auto dimension(hana::size_t< DI > i)noexcept{
@@ -80,8 +104,15 @@ namespace disposer{
 		}
 
 		/// \brief Get access to the state object if one exists
+		///
+		/// A per_worker_state object is only used by the thread that runs
+		/// the exec, so it needs no locking. The functions passed to the
+		/// parallel helpers run on other workers too and must not access
+		/// it.
 		auto& state()noexcept{
 			static_assert(!std::is_void_v< State >, "Module has no state.");
+			assert(state_owner_ == std::thread::id()
+				|| state_owner_ == std::this_thread::get_id());
 			return *state_;
 		}
 
@@ -115,6 +146,101 @@ namespace disposer{
 		}
 
 
+		/// \brief Values the caller passed to chain::exec()
+		exec_arguments& arguments()const noexcept{
+			return module_.arguments();
+		}
+
+		/// \brief Values chain::exec() returns to the caller
+		///
+		/// Throws std::logic_error if the module runs outside of a chain.
+		exec_results& results()const{
+			auto const results = module_.results();
+			if(!results){
+				throw std::logic_error("module runs outside of a chain and "
+					"can not return results");
+			}
+			return *results;
+		}
+
+
+		/// \brief Call fn(begin, end) for disjoint chunks of [0, count) in
+		///        parallel
+		///
+		/// The calls run on the calling thread and the workers of the system
+		/// executor, see \ref disposer::parallel_chunks.
+		template < typename Fn >
+		void parallel_chunks(std::size_t const count, Fn&& fn)const{
+			disposer::parallel_chunks(module_.executor(),
+				module_.scheduling(), count, fn);
+		}
+
+		/// \brief Call fn(i) for all i in [0, count) or fn(element) for all
+		///        elements of a random access range in parallel
+		///
+		/// The calls run on the calling thread and the workers of the system
+		/// executor, see \ref disposer::parallel_chunks.
+		template < typename CountOrRange, typename Fn >
+		void parallel_for(CountOrRange&& count_or_range, Fn&& fn)const{
+			if constexpr(std::is_integral_v<
+				std::remove_reference_t< CountOrRange > >
+			){
+				parallel_chunks(static_cast< std::size_t >(count_or_range),
+					[&fn](std::size_t const begin, std::size_t const end){
+						for(auto i = begin; i < end; ++i) fn(i);
+					});
+			}else{
+				auto& range = count_or_range;
+				parallel_chunks(std::size(range),
+					[&fn, &range](std::size_t const begin, std::size_t end){
+						for(auto i = begin; i < end; ++i) fn(range[i]);
+					});
+			}
+		}
+
+		/// \brief Assign out[i] = fn(range[i]) for all elements of a random
+		///        access range in parallel
+		template < typename Range, typename OutputIt, typename Fn >
+		void parallel_transform(Range const& range, OutputIt out, Fn&& fn)const{
+			parallel_chunks(std::size(range),
+				[&fn, &range, out](std::size_t const begin, std::size_t end){
+					for(auto i = begin; i < end; ++i) out[i] = fn(range[i]);
+				});
+		}
+
+		/// \brief Combine init and all elements of a random access range
+		///        with the associative operation op in parallel
+		///
+		/// The elements are combined in chunks, the chunk results are
+		/// combined in range order, so op needs not to be commutative.
+		template < typename Range, typename T, typename Op >
+		T parallel_reduce(Range const& range, T init, Op&& op)const{
+			std::mutex mutex;
+			std::vector< std::pair< std::size_t, T > > partial;
+			parallel_chunks(std::size(range),
+				[&op, &range, &mutex, &partial](
+					std::size_t const begin,
+					std::size_t const end
+				){
+					T result = range[begin];
+					for(auto i = begin + 1; i < end; ++i){
+						result = op(std::move(result), range[i]);
+					}
+
+					std::lock_guard lock(mutex);
+					partial.emplace_back(begin, std::move(result));
+				});
+
+			std::sort(partial.begin(), partial.end(),
+				[](auto const& a, auto const& b){ return a.first < b.first; });
+			for(auto& [begin, value]: partial){
+				(void)begin; // silance GCC
+				init = op(std::move(init), std::move(value));
+			}
+			return init;
+		}
+
+
 	private:
 		template < typename This, typename Name >
 		static auto& get(This& this_, Name const& name)noexcept{
@@ -158,6 +284,11 @@ namespace disposer{
 		/// nullptr-pointer to void if module is stateless.
 		State* state_;
 
+		/// \brief Thread that may access an exclusive state object
+		///
+		/// Default constructed if the state object is shared.
+		std::thread::id const state_owner_;
+
 		/// \brief hana::tuple of exec_inputs
 		ExecInputs& inputs_;
 
@@ -182,7 +313,8 @@ namespace disposer{
 	module_ref(
 		exec_module< TypeList, Inputs, Outputs, Parameters,
 			ModuleInitFn, ExecFn, CanRunConcurrent, Component >& module,
-		State* state
+		State* state,
+		bool exclusive_state = false
 	) -> module_ref<
 		TypeList,
 		State,
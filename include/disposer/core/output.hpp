@@ -12,8 +12,13 @@
 #include "output_base.hpp"
 #include "output_name.hpp"
 
+#include "../tool/to_std_string.hpp"
+
 #include <boost/hana/core/is_a.hpp>
 
+#include <stdexcept>
+#include <type_traits>
+
 
 namespace disposer{
 
@@ -21,6 +26,12 @@ namespace disposer{
 	/// \brief Hana Tag for output
 	struct output_tag{};
 
+	/// \brief true if the data of an output of type T can be moved into a
+	///        mapped file
+	template < typename T >
+	constexpr bool is_spillable_type =
+		std::is_trivially_copyable_v< T > && !std::is_same_v< T, bool >;
+
 	/// \brief The actual output type
 	template < typename Name, typename T >
 	class output: public output_base{
@@ -45,8 +56,24 @@ namespace disposer{
 
 
 		/// \brief Constructor
-		output(std::size_t use_count)
-			: output_base(use_count) {}
+		///
+		/// Throws std::logic_error if spill_threshold is set for a type that
+		/// can not be spilled.
+		output(
+			std::size_t use_count,
+			std::size_t stream_capacity = 0,
+			std::size_t spill_threshold = 0
+		)
+			: output_base(use_count, stream_capacity, spill_threshold)
+		{
+			if(spill_threshold > 0 && !is_spillable_type< T >){
+				throw std::logic_error("output("
+					+ detail::to_std_string(name) + ") of type "
+					+ type_index::type_id< T >().pretty_name()
+					+ " can not be spilled, only trivially copyable types "
+					"except bool can");
+			}
+		}
 
 
 	private:
@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__output_appender__hpp_INCLUDED_
+#define _disposer__core__output_appender__hpp_INCLUDED_
+
+#include <logsys/stdlogb.hpp>
+
+#include <vector>
+#include <cstddef>
+
+
+namespace disposer{
+
+
+	template < typename T >
+	class unnamed_exec_output;
+
+
+	/// \brief Thread local buffer to fill an output from parallel code
+	///
+	/// Every thread of a module that parallelizes internally creates its own
+	/// appender via the appender() function of the output. The elements are
+	/// collected without synchronization and handed to the output by
+	/// commit() or the destructor. Only an explicit commit() reports errors,
+	/// the destructor logs and drops them. When the module finished, all
+	/// committed buffers are appended to the output sorted by their order
+	/// key. Use distinct keys (e.g. the chunk index) for a deterministic
+	/// order, buffers with equal keys are appended in commit order.
+	///
+	/// For stream outputs the elements are passed on commit, without
+	/// ordering.
+	template < typename T >
+	class output_appender{
+	public:
+		/// \brief Constructor
+		output_appender(unnamed_exec_output< T >& output, std::size_t order)
+			noexcept
+			: output_(&output)
+			, order_(order) {}
+
+		/// \brief Move constructor
+		output_appender(output_appender&& other)noexcept
+			: output_(other.output_)
+			, order_(other.order_)
+			, data_(std::move(other.data_))
+		{
+			other.output_ = nullptr;
+		}
+
+		/// \brief Not copyable
+		output_appender(output_appender const&) = delete;
+
+		/// \brief Not assignable
+		output_appender& operator=(output_appender const&) = delete;
+
+		/// \brief Commit the remaining elements
+		///
+		/// Errors are logged, the elements are lost in this case.
+		~output_appender(){
+			if(!output_ || data_.empty()) return;
+
+			output_->exception_catching_log(
+				[this](logsys::stdlogb& os){
+					os << "commit " << data_.size()
+						<< " elements of destroyed appender";
+				},
+				[this]{
+					commit();
+				});
+		}
+
+
+		/// \brief Add an element to the local buffer
+		template < typename ... Args >
+		void emplace(Args&& ... args){
+			data_.emplace_back(static_cast< Args&& >(args) ...);
+		}
+
+		/// \brief Add an element to the local buffer
+		template < typename Arg >
+		void push(Arg&& value){
+			data_.push_back(static_cast< Arg&& >(value));
+		}
+
+		/// \brief Reserve memory in the local buffer
+		void reserve(std::size_t count){
+			data_.reserve(count);
+		}
+
+
+		/// \brief Hand the buffered elements to the output
+		///
+		/// The appender can be used further, the following elements are
+		/// committed with the same order key. Throws if the buffer can't be
+		/// handed over, call it explicitly to handle such errors.
+		void commit(){
+			if(!output_ || data_.empty()) return;
+			output_->append_chunk(order_, std::move(data_));
+			data_.clear();
+		}
+
+
+	private:
+		/// \brief The output or nullptr after move
+		unnamed_exec_output< T >* output_;
+
+		/// \brief Key for merging the buffers
+		std::size_t const order_;
+
+		/// \brief Locally collected elements
+		std::vector< T > data_;
+	};
+
+
+}
+
+
+#endif
@@ -27,8 +27,14 @@ namespace disposer{
 	class output_base{
 	public:
 		/// \brief Constructor
-		output_base(std::size_t use_count)noexcept
-			: use_count_(use_count) {}
+		output_base(
+			std::size_t use_count,
+			std::size_t stream_capacity = 0,
+			std::size_t spill_threshold = 0
+		)noexcept
+			: use_count_(use_count)
+			, stream_capacity_(stream_capacity)
+			, spill_threshold_(spill_threshold) {}
 
 		/// \brief Outputs are not copyable
 		output_base(output_base const&) = delete;
@@ -51,10 +57,42 @@ namespace disposer{
 		/// \brief The count of connected inputs
 		std::size_t use_count()const noexcept{ return use_count_; }
 
+		/// \brief Forget a connected input whose module was removed from
+		///        the chain
+		void remove_use()noexcept{ --use_count_; }
+
+		/// \brief Count of elements the stream may buffer, 0 if the output
+		///        is not declared as stream
+		std::size_t stream_capacity()const noexcept{ return stream_capacity_; }
+
+		/// \brief true if the data is passed element by element while the
+		///        producer is still running
+		///
+		/// Streaming is only done if exactly one input is connected,
+		/// otherwise the output behaves like a normal output.
+		bool is_stream()const noexcept{
+			return stream_capacity_ > 0 && use_count_ == 1;
+		}
+
+		/// \brief Let the output behave like a normal output
+		///
+		/// Used by chains that don't run their modules concurrently.
+		void disable_stream()noexcept{ stream_capacity_ = 0; }
+
+		/// \brief Size in bytes from which the data is moved to a temporary
+		///        file, 0 if the output is not declared as spillable
+		std::size_t spill_threshold()const noexcept{ return spill_threshold_; }
+
 
 	private:
 		/// \brief The count of connected inputs
-		std::size_t const use_count_;
+		std::size_t use_count_;
+
+		/// \brief Count of elements the stream may buffer
+		std::size_t stream_capacity_;
+
+		/// \brief Size in bytes from which the data is spilled
+		std::size_t const spill_threshold_;
 	};
 
 
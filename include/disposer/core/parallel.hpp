@@ -0,0 +1,48 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__parallel__hpp_INCLUDED_
+#define _disposer__core__parallel__hpp_INCLUDED_
+
+#include <functional>
+
+
+namespace disposer{
+
+
+	class executor;
+	class scheduling_class;
+
+
+	/// \brief Call fn(begin, end) for disjoint chunks that cover
+	///        [0, count)
+	///
+	/// The chunks are processed by the calling thread together with up to
+	/// worker_count() workers of the executor, so no threads beyond the
+	/// pool are started. The call returns after all chunks are done. If fn
+	/// throws, the remaining chunks are skipped and the first exception is
+	/// rethrown.
+	///
+	/// Without executor all chunks run on the calling thread.
+	///
+	/// \param executor Worker threads or nullptr
+	/// \param scheduling Class of the posted tasks or nullptr for the
+	///                   default class
+	/// \param count Count of elements
+	/// \param fn Function that processes the elements [begin, end)
+	void parallel_chunks(
+		executor* executor,
+		scheduling_class* scheduling,
+		std::size_t count,
+		std::function< void(std::size_t, std::size_t) > const& fn);
+
+
+}
+
+
+#endif
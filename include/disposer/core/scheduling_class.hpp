@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__scheduling_class__hpp_INCLUDED_
+#define _disposer__core__scheduling_class__hpp_INCLUDED_
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace disposer{
+
+
+	class executor;
+
+
+	/// \brief Decides which queued task of an executor runs next
+	///
+	/// - Tasks of a higher priority always run first.
+	/// - Among equal priorities, tasks with an earlier deadline run first,
+	///   tasks without a deadline run last.
+	/// - Otherwise the classes share the workers proportional to their
+	///   weight (start-time fair queueing).
+	///
+	/// A chain owns one object for all its tasks.
+	class scheduling_class{
+	public:
+		/// \brief Constructor
+		scheduling_class(
+			int priority = 0,
+			std::size_t weight = 1,
+			std::chrono::nanoseconds deadline = std::chrono::nanoseconds(0)
+		)noexcept
+			: priority(priority)
+			, weight(weight > 0 ? weight : 1)
+			, deadline(deadline) {}
+
+		/// \brief Not copyable, the executor refers to it
+		scheduling_class(scheduling_class const&) = delete;
+
+		/// \brief Not copy-assignable
+		scheduling_class& operator=(scheduling_class const&) = delete;
+
+
+		/// \brief Tasks of a higher priority always run first
+		int const priority;
+
+		/// \brief Share of the workers relative to other classes of the
+		///        same priority
+		std::size_t const weight;
+
+		/// \brief Deadline of an exec relative to its start, 0 if none
+		std::chrono::nanoseconds const deadline;
+
+
+	private:
+		/// \brief Virtual time at which the next task of the class starts
+		///
+		/// Managed by the executor while its mutex is locked.
+		std::uint64_t virtual_time_ = 0;
+
+		friend class executor;
+	};
+
+
+}
+
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "directory.hpp"
 #include "chain.hpp"
+#include "trigger_queue.hpp"
 
 #include "../config/parse_config.hpp"
 
@@ -88,6 +89,39 @@ namespace disposer{
 		chain& get_chain(std::string const& chain);
 
 
+		/// \brief Bytes held by output data of running execs of all chains
+		///
+		/// Use memory().set_budget() to limit the admission of new execs
+		/// over all chains.
+		memory_usage& memory()noexcept{
+			return memory_;
+		}
+
+		/// \brief Bytes held by output data of running execs of all chains
+		memory_usage const& memory()const noexcept{
+			return memory_;
+		}
+
+
+		/// \brief Worker threads of chains with executor = adaptive
+		disposer::executor& executor()noexcept{
+			return executor_;
+		}
+
+		/// \brief Worker threads of chains with executor = adaptive
+		disposer::executor const& executor()const noexcept{
+			return executor_;
+		}
+
+		/// \brief Fire-and-forget exec requests for the chains
+		///
+		/// Use triggers().trigger("name") in event callbacks that must not
+		/// block until the chain finished.
+		trigger_queue& triggers()noexcept{
+			return triggers_;
+		}
+
+
 	private:
 		/// \brief Mutex
 		mutable std::mutex mutex_;
@@ -101,6 +135,22 @@ namespace disposer{
 		disposer::directory directory_;
 
 
+		/// \brief Accounting of the output data of all chains
+		///
+		/// Must be declared before chains_.
+		memory_usage memory_;
+
+		/// \brief Worker threads of the chains
+		///
+		/// Must be declared before chains_.
+		disposer::executor executor_;
+
+		/// \brief Queued exec requests
+		///
+		/// Shut down by the destructor before the components.
+		trigger_queue triggers_{*this, executor_};
+
+
 		/// \brief Currect configuration
 		types::parse::config config_;
 
@@ -76,6 +76,22 @@ namespace disposer{
 		}
 
 
+		/// \brief Bytes held by output data of running execs of all chains
+		memory_usage& memory()const noexcept{
+			return system_.memory();
+		}
+
+		/// \brief Worker threads of chains with executor = adaptive
+		disposer::executor& executor()const noexcept{
+			return system_.executor();
+		}
+
+		/// \brief Fire-and-forget exec requests for the chains
+		trigger_queue& triggers()const noexcept{
+			return system_.triggers();
+		}
+
+
 		/// \brief Name of the component
 		std::string_view component_name()const noexcept{
 			return component_name_;
@@ -0,0 +1,149 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__core__trigger_queue__hpp_INCLUDED_
+#define _disposer__core__trigger_queue__hpp_INCLUDED_
+
+#include "exec_info.hpp"
+#include "executor.hpp"
+
+#include "../tool/mpmc_queue.hpp"
+
+#include <string>
+#include <thread>
+
+#include <semaphore.h>
+
+
+namespace disposer{
+
+
+	class system;
+
+
+	/// \brief Fire-and-forget exec requests for the chains of a system
+	///
+	/// trigger() never blocks and never waits for the chain, so it can be
+	/// called from event callbacks of hardware drivers. A dispatcher thread
+	/// hands the requests to the worker threads of the system executor.
+	/// trigger() only wakes it via a semaphore, it never takes a lock.
+	class trigger_queue{
+	public:
+		/// \brief Called with the result of a triggered exec
+		///
+		/// The optional is empty if the chain could not be executed, e.g.
+		/// because it doesn't exist or is not enabled. The callback runs
+		/// on a worker thread and must not throw.
+		using callback = std::function< void(std::optional< exec_info >) >;
+
+
+		/// \brief Constructor
+		trigger_queue(
+			class system& system,
+			disposer::executor& executor,
+			std::size_t capacity = 1024
+		);
+
+		/// \brief Waits for all queued requests and ends the dispatcher, see
+		///        shutdown()
+		~trigger_queue();
+
+		/// \brief Not copyable
+		trigger_queue(trigger_queue const&) = delete;
+
+		/// \brief Not copy-assignable
+		trigger_queue& operator=(trigger_queue const&) = delete;
+
+
+		/// \brief Request an exec of the chain
+		///
+		/// Returns false without blocking if the queue is full or shut
+		/// down. The chain is looked up by the dispatcher.
+		bool trigger(std::string chain, callback on_done = {});
+
+
+		/// \brief Count of requests that are queued or running
+		std::size_t pending()const noexcept{
+			return active_;
+		}
+
+
+		/// \brief Reject new requests, wait for the queued ones and end the
+		///        dispatcher
+		///
+		/// Called by the destructor of the system before its components are
+		/// shut down.
+		void shutdown();
+
+
+	private:
+		/// \brief A queued exec request
+		struct request{
+			/// \brief Name of the chain
+			std::string chain;
+
+			/// \brief Optional callback
+			callback on_done;
+		};
+
+
+		/// \brief Function of the dispatcher thread
+		///
+		/// Moves all queued requests to the executor and sleeps until
+		/// trigger() or shutdown() wake it.
+		void dispatch()noexcept;
+
+		/// \brief Wake the dispatcher if it sleeps
+		void wake()noexcept;
+
+		/// \brief Exec the chain of the request and call its callback
+		void exec(request& request)noexcept;
+
+		/// \brief Count a finished request
+		void finish()noexcept;
+
+
+		/// \brief The system that owns the chains
+		class system& system_;
+
+		/// \brief Worker threads of the system
+		disposer::executor& executor_;
+
+		/// \brief The requests that wait for the dispatcher
+		mpmc_queue< request > queue_;
+
+		/// \brief true while the dispatcher is about to sleep or sleeps
+		std::atomic< bool > sleeping_{false};
+
+		/// \brief true after shutdown()
+		std::atomic< bool > closed_{false};
+
+		/// \brief true if the dispatcher should end
+		std::atomic< bool > stop_{false};
+
+		/// \brief The dispatcher sleeps on it
+		sem_t wake_;
+
+		/// \brief Count of accepted requests that did not finish
+		std::atomic< std::size_t > active_{0};
+
+		/// \brief Protects waiting in shutdown()
+		std::mutex mutex_;
+
+		/// \brief Signaled if the last request finished after shutdown()
+		std::condition_variable cv_;
+
+		/// \brief Runs dispatch(), started last
+		std::thread dispatcher_;
+	};
+
+
+}
+
+
+#endif
@@ -10,5 +10,8 @@
 #define _disposer__module__hpp_INCLUDED_
 
 #include "core/generate_module.hpp"
+#include "core/element_wise.hpp"
+#include "core/external_input.hpp"
+#include "core/external_output.hpp"
 
 #endif
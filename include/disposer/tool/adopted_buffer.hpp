@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__adopted_buffer__hpp_INCLUDED_
+#define _disposer__tool__adopted_buffer__hpp_INCLUDED_
+
+#include "span.hpp"
+
+#include <memory>
+#include <type_traits>
+
+
+namespace disposer{
+
+
+	/// \brief Read only view to memory owned elsewhere
+	///
+	/// Wraps a buffer of a DMA engine, a mmap region or a frame pool without
+	/// copying it. The release callback runs exactly once, after the last
+	/// copy of the adopted_buffer is destroyed. As output type this is the
+	/// cleanup() of the last connected input, unless a consumer keeps a
+	/// copy.
+	template < typename T >
+	class adopted_buffer{
+	public:
+		/// \brief Element type
+		using value_type = T;
+
+		/// \brief Size type
+		using size_type = std::size_t;
+
+		/// \brief Constant random access iterator
+		using const_iterator = T const*;
+
+		/// \brief Constant random access iterator
+		using iterator = const_iterator;
+
+
+		/// \brief Adopt size elements at data
+		///
+		/// release() is called when the buffer is no longer referenced, it
+		/// must not throw.
+		template < typename Release >
+		adopted_buffer(T const* data, size_type size, Release&& release)
+			: data_(data)
+			, size_(size)
+			, owner_(data, [release = static_cast< Release&& >(release)]
+				(T const*)mutable noexcept{ release(); }) {}
+
+
+		/// \brief Pointer to the first element
+		T const* data()const noexcept{ return data_; }
+
+		/// \brief Count of elements
+		size_type size()const noexcept{ return size_; }
+
+		/// \brief true if the buffer has no elements
+		bool empty()const noexcept{ return size_ == 0; }
+
+		/// \brief Access specified element
+		T const& operator[](size_type pos)const noexcept{
+			return data_[pos];
+		}
+
+		/// \brief Contiguous view of the buffer
+		disposer::span< T const > as_span()const noexcept{
+			return {data_, size_};
+		}
+
+
+		/// \brief Iterator to the beginning
+		const_iterator begin()const noexcept{ return data_; }
+
+		/// \brief Iterator to the end
+		const_iterator end()const noexcept{ return data_ + size_; }
+
+
+		/// \brief Count of adopted_buffer objects sharing the memory
+		long use_count()const noexcept{ return owner_.use_count(); }
+
+		/// \brief Only the view is held, the memory is owned elsewhere
+		std::size_t memory_size()const noexcept{ return sizeof(*this); }
+
+
+	private:
+		/// \brief Pointer to the first element
+		T const* data_;
+
+		/// \brief Count of elements
+		size_type size_;
+
+		/// \brief Calls the release callback with the last reference
+		std::shared_ptr< T const > owner_;
+	};
+
+
+	/// \brief true if T is an adopted_buffer
+	template < typename T >
+	struct is_adopted_buffer: std::false_type{};
+
+	template < typename T >
+	struct is_adopted_buffer< adopted_buffer< T > >: std::true_type{};
+
+
+}
+
+
+#endif
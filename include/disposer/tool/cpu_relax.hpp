@@ -0,0 +1,36 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__cpu_relax__hpp_INCLUDED_
+#define _disposer__tool__cpu_relax__hpp_INCLUDED_
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+
+namespace disposer{
+
+
+	/// \brief Hint to the CPU that the calling thread is in a spin loop
+	///
+	/// Reduces the power consumption and the penalty of leaving the loop
+	/// and gives the other hyper thread of the core more resources.
+	inline void cpu_relax()noexcept{
+#if defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		asm volatile("yield" ::: "memory");
+#endif
+	}
+
+
+}
+
+
+#endif
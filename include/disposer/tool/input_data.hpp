@@ -9,7 +9,13 @@
 #ifndef _disposer__tool__input_data__hpp_INCLUDED_
 #define _disposer__tool__input_data__hpp_INCLUDED_
 
+#include "span.hpp"
+
 #include <vector>
+#include <string>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 
 
 namespace disposer{
@@ -101,6 +107,25 @@ namespace disposer{
 		size_type size()const noexcept{ return data_.size(); }
 
 
+		/// \brief Writable contiguous view of the owned data
+		///
+		/// Not available for bool, std::vector< bool > is not contiguous.
+		disposer::span< T > as_span()& noexcept{
+			static_assert(!std::is_same_v< T, bool >,
+				"std::vector< bool > has no contiguous memory");
+			return data_;
+		}
+
+		/// \brief Contiguous view of the data
+		///
+		/// Not available for bool, std::vector< bool > is not contiguous.
+		disposer::span< T const > as_span()const& noexcept{
+			static_assert(!std::is_same_v< T, bool >,
+				"std::vector< bool > has no contiguous memory");
+			return data_;
+		}
+
+
 		/// \brief Returns a move iterator to the beginning
 		iterator begin()noexcept{
 			return iterator(data_.begin());
@@ -172,20 +197,26 @@ namespace disposer{
 
 
 	/// \brief Read only range view to input data
+	///
+	/// The data is either a std::vector or a contiguous memory range, for
+	/// example a memory-mapped spill file of the output.
 	template < typename T >
 	class input_data< T, true >{
 		using container_type = std::vector< T >;
+
+		/// \brief std::vector< bool > is not contiguous
+		static constexpr bool is_contiguous = !std::is_same_v< T, bool >;
+
 	public:
-		/// \brief Move random access iterator
-		using iterator =
-			typename container_type::const_iterator;
+		/// \brief Constant random access iterator
+		using iterator = std::conditional_t< is_contiguous,
+			T const*, typename container_type::const_iterator >;
 
 		/// \brief Constant random access iterator
 		using const_iterator = iterator;
 
-		/// \brief Reverse move random access iterator
-		using reverse_iterator =
-			typename container_type::const_reverse_iterator;
+		/// \brief Reverse constant random access iterator
+		using reverse_iterator = std::reverse_iterator< iterator >;
 
 		/// \brief Constant reverse random access iterator
 		using const_reverse_iterator = reverse_iterator;
@@ -195,8 +226,17 @@ namespace disposer{
 
 
 		/// \brief Constructor
-		input_data(container_type const& data)
-			: data_(data) {}
+		input_data(container_type const& data)noexcept
+			: first_(begin_of(data))
+			, last_(first_ + data.size()) {}
+
+		/// \brief Constructor for data in contiguous memory
+		input_data(T const* data, size_type size)noexcept
+			: first_(data)
+			, last_(data + size)
+		{
+			static_assert(is_contiguous);
+		}
 
 		/// \brief input_data is nighter copy nor movable
 		input_data(input_data const&) = delete;
@@ -207,70 +247,99 @@ namespace disposer{
 
 		/// \brief Access specified element with bounds checking
 		T const& at(size_type pos)const&{
-			return data_.at(pos);
+			if(pos >= size()){
+				throw std::out_of_range("input_data::at: pos ("
+					+ std::to_string(pos) + ") >= size ("
+					+ std::to_string(size()) + ")");
+			}
+			return first_[pos];
 		}
 
 		/// \brief Access specified element
-		T const& operator[](size_type pos)const&
-		noexcept(noexcept(std::declval< container_type const& >()[pos])){
-			return data_[pos];
+		T const& operator[](size_type pos)const& noexcept{
+			return first_[pos];
 		}
 
 
 		/// \brief Checks whether the container is empty
-		bool empty()const noexcept{ return data_.empty(); }
+		bool empty()const noexcept{ return first_ == last_; }
 
 		/// \brief Returns the number of elements
-		size_type size()const noexcept{ return data_.size(); }
+		size_type size()const noexcept{
+			return static_cast< size_type >(last_ - first_);
+		}
+
+
+		/// \brief Contiguous view of the data
+		///
+		/// Not available for bool, std::vector< bool > is not contiguous.
+		disposer::span< T const > as_span()const noexcept{
+			static_assert(is_contiguous,
+				"std::vector< bool > has no contiguous memory");
+			return {first_, last_};
+		}
 
 
 		/// \brief Returns a constant iterator to the beginning
 		const_iterator begin()const noexcept{
-			return data_.begin();
+			return first_;
 		}
 
 		/// \brief Returns a constant iterator to the beginning
 		const_iterator cbegin()const noexcept{
-			return data_.cbegin();
+			return first_;
 		}
 
 
 		/// \brief Returns a constant iterator to the end
 		const_iterator end()const noexcept{
-			return data_.end();
+			return last_;
 		}
 
 		/// \brief Returns a constant iterator to the end
 		const_iterator cend()const noexcept{
-			return data_.cend();
+			return last_;
 		}
 
 
 		/// \brief Returns a reverse constant iterator to the beginning
 		const_reverse_iterator rbegin()const noexcept{
-			return data_.rbegin();
+			return const_reverse_iterator(last_);
 		}
 
 		/// \brief Returns a reverse constant iterator to the beginning
 		const_reverse_iterator crbegin()const noexcept{
-			return data_.crbegin();
+			return const_reverse_iterator(last_);
 		}
 
 
 		/// \brief Returns a reverse constant iterator to the end
 		const_reverse_iterator rend()const noexcept{
-			return data_.rend();
+			return const_reverse_iterator(first_);
 		}
 
 		/// \brief Returns a reverse constant iterator to the end
 		const_reverse_iterator crend()const noexcept{
-			return data_.crend();
+			return const_reverse_iterator(first_);
 		}
 
 
 	private:
-		/// \brief rvalue reference to the data
-		container_type const& data_;
+		/// \brief Iterator to the first element of a vector
+		static iterator begin_of(container_type const& data)noexcept{
+			if constexpr(is_contiguous){
+				return data.data();
+			}else{
+				return data.begin();
+			}
+		}
+
+
+		/// \brief Iterator to the first element
+		iterator const first_;
+
+		/// \brief Iterator behind the last element
+		iterator const last_;
 	};
 
 
@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__managed_blocking__hpp_INCLUDED_
+#define _disposer__tool__managed_blocking__hpp_INCLUDED_
+
+
+namespace disposer{
+
+
+	/// \brief Gets informed if a thread is about to block
+	///
+	/// A thread pool implements this to start a compensation thread while one
+	/// of its workers waits, so the pool can't run out of workers.
+	class blocking_handler{
+	public:
+		/// \brief The calling thread is going to block
+		virtual void begin_blocking()noexcept = 0;
+
+		/// \brief The calling thread continues
+		virtual void end_blocking()noexcept = 0;
+
+	protected:
+		~blocking_handler() = default;
+	};
+
+
+	/// \brief Handler of the calling thread, nullptr for foreign threads
+	inline blocking_handler*& current_blocking_handler()noexcept{
+		static thread_local blocking_handler* handler = nullptr;
+		return handler;
+	}
+
+
+	/// \brief Informs the handler of the calling thread about a wait
+	///
+	/// Create an object directly before a wait that might take long, e.g.
+	/// on a condition variable.
+	class managed_blocking{
+	public:
+		/// \brief Call begin_blocking()
+		managed_blocking()noexcept
+			: handler_(current_blocking_handler())
+		{
+			if(handler_) handler_->begin_blocking();
+		}
+
+		/// \brief Call end_blocking()
+		~managed_blocking(){
+			if(handler_) handler_->end_blocking();
+		}
+
+		/// \brief Not copyable
+		managed_blocking(managed_blocking const&) = delete;
+
+		/// \brief Not copy-assignable
+		managed_blocking& operator=(managed_blocking const&) = delete;
+
+
+	private:
+		/// \brief Handler of the calling thread
+		blocking_handler* const handler_;
+	};
+
+
+}
+
+
+#endif
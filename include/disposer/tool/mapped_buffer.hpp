@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__mapped_buffer__hpp_INCLUDED_
+#define _disposer__tool__mapped_buffer__hpp_INCLUDED_
+
+#include <cstddef>
+
+
+namespace disposer{
+
+
+	/// \brief Memory backed by an anonymous temporary file
+	///
+	/// The file is created in $TMPDIR (or /tmp) and unlinked immediately, so
+	/// it vanishes with the mapping. The kernel can write the pages back to
+	/// disk instead of holding them in RAM.
+	///
+	/// Throws std::system_error if the file can not be created or mapped.
+	class mapped_buffer{
+	public:
+		/// \brief Create a mapped file of size bytes
+		explicit mapped_buffer(std::size_t bytes);
+
+		/// \brief Unmap the file
+		~mapped_buffer();
+
+		/// \brief Not copyable
+		mapped_buffer(mapped_buffer const&) = delete;
+
+		/// \brief Not copy-assignable
+		mapped_buffer& operator=(mapped_buffer const&) = delete;
+
+
+		/// \brief Begin of the mapped memory
+		void* data()const noexcept{
+			return data_;
+		}
+
+		/// \brief Size of the mapped memory in bytes
+		std::size_t size()const noexcept{
+			return size_;
+		}
+
+
+	private:
+		/// \brief Begin of the mapped memory
+		void* data_;
+
+		/// \brief Size of the mapped memory in bytes
+		std::size_t const size_;
+	};
+
+
+}
+
+
+#endif
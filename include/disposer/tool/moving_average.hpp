@@ -0,0 +1,66 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__moving_average__hpp_INCLUDED_
+#define _disposer__tool__moving_average__hpp_INCLUDED_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+
+namespace disposer{
+
+
+	/// \brief Exponential moving average of durations
+	///
+	/// Every new sample has a weight of 1/8. Concurrent add() calls may lose
+	/// samples, which is fine for a cost estimation.
+	class moving_average{
+	public:
+		/// \brief Constructor
+		moving_average()noexcept
+			: value_(-1) {}
+
+		/// \brief Not copyable
+		moving_average(moving_average const&) = delete;
+
+		/// \brief Not copy-assignable
+		moving_average& operator=(moving_average const&) = delete;
+
+
+		/// \brief Add a sample
+		void add(std::chrono::nanoseconds const sample)noexcept{
+			auto const value = value_.load(std::memory_order_relaxed);
+			auto const ns = static_cast< std::int64_t >(sample.count());
+			value_.store(value < 0 ? ns : value + (ns - value) / 8,
+				std::memory_order_relaxed);
+		}
+
+		/// \brief true if no sample was added yet
+		bool empty()const noexcept{
+			return value_.load(std::memory_order_relaxed) < 0;
+		}
+
+		/// \brief The average, 0 if empty
+		std::chrono::nanoseconds get()const noexcept{
+			auto const value = value_.load(std::memory_order_relaxed);
+			return std::chrono::nanoseconds(value < 0 ? 0 : value);
+		}
+
+
+	private:
+		/// \brief Average in nanoseconds, -1 if empty
+		std::atomic< std::int64_t > value_;
+	};
+
+
+}
+
+
+#endif
@@ -0,0 +1,149 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__mpmc_queue__hpp_INCLUDED_
+#define _disposer__tool__mpmc_queue__hpp_INCLUDED_
+
+#include <optional>
+#include <atomic>
+#include <memory>
+
+
+namespace disposer{
+
+
+	/// \brief Bounded lock-free queue for multiple producers and consumers
+	///
+	/// Every slot has a sequence number that tells producers and consumers
+	/// whether the slot is free or filled in the current round. Neither
+	/// try_push() nor try_pop() ever block.
+	template < typename T >
+	class mpmc_queue{
+	public:
+		/// \brief Constructor
+		///
+		/// The capacity is rounded up to the next power of two.
+		explicit mpmc_queue(std::size_t capacity)
+			: mask_(round_up(capacity) - 1)
+			, cells_(std::make_unique< cell[] >(mask_ + 1))
+		{
+			for(std::size_t i = 0; i <= mask_; ++i){
+				cells_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		/// \brief Queues are not copyable
+		mpmc_queue(mpmc_queue const&) = delete;
+
+		/// \brief Queues are not copy-assignable
+		mpmc_queue& operator=(mpmc_queue const&) = delete;
+
+
+		/// \brief Maximum count of elements
+		std::size_t capacity()const noexcept{
+			return mask_ + 1;
+		}
+
+
+		/// \brief Add an element, returns false if the queue is full
+		template < typename ... Args >
+		bool try_emplace(Args&& ... args){
+			auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+			for(;;){
+				auto& c = cells_[pos & mask_];
+				auto const seq = c.sequence.load(std::memory_order_acquire);
+				auto const diff = static_cast< std::ptrdiff_t >(seq - pos);
+				if(diff == 0){
+					if(enqueue_pos_.compare_exchange_weak(
+						pos, pos + 1, std::memory_order_relaxed))
+					{
+						c.value.emplace(static_cast< Args&& >(args) ...);
+						c.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}else if(diff < 0){
+					return false;
+				}else{
+					pos = enqueue_pos_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// \brief Get the oldest element, returns an empty optional if the
+		///        queue is empty
+		std::optional< T > try_pop(){
+			auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+			for(;;){
+				auto& c = cells_[pos & mask_];
+				auto const seq = c.sequence.load(std::memory_order_acquire);
+				auto const diff =
+					static_cast< std::ptrdiff_t >(seq - (pos + 1));
+				if(diff == 0){
+					if(dequeue_pos_.compare_exchange_weak(
+						pos, pos + 1, std::memory_order_relaxed))
+					{
+						std::optional< T > result(std::move(c.value));
+						c.value.reset();
+						c.sequence.store(pos + mask_ + 1,
+							std::memory_order_release);
+						return result;
+					}
+				}else if(diff < 0){
+					return {};
+				}else{
+					pos = dequeue_pos_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+
+		/// \brief true if no element is queued
+		///
+		/// Only a snapshot while other threads push or pop.
+		bool empty()const noexcept{
+			return enqueue_pos_.load(std::memory_order_acquire)
+				== dequeue_pos_.load(std::memory_order_acquire);
+		}
+
+
+	private:
+		/// \brief A slot of the ring buffer
+		struct cell{
+			/// \brief Position of the push or pop that may use the slot next
+			std::atomic< std::size_t > sequence;
+
+			/// \brief The element if the slot is filled
+			std::optional< T > value;
+		};
+
+		/// \brief Next power of two
+		static std::size_t round_up(std::size_t const capacity)noexcept{
+			std::size_t result = 1;
+			while(result < capacity) result <<= 1;
+			return result;
+		}
+
+
+		/// \brief Capacity minus 1
+		std::size_t const mask_;
+
+		/// \brief The ring buffer
+		std::unique_ptr< cell[] > const cells_;
+
+		/// \brief Position of the next push, on its own cache line
+		alignas(64) std::atomic< std::size_t > enqueue_pos_{0};
+
+		/// \brief Position of the next pop, on its own cache line
+		alignas(64) std::atomic< std::size_t > dequeue_pos_{0};
+	};
+
+
+}
+
+
+#endif
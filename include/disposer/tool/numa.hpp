@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__numa__hpp_INCLUDED_
+#define _disposer__tool__numa__hpp_INCLUDED_
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace disposer{
+
+
+	/// \brief Count of NUMA nodes with memory, 1 on non NUMA systems
+	///
+	/// The value is determined once.
+	std::size_t numa_node_count()noexcept;
+
+	/// \brief NUMA node of the CPU the calling thread currently runs on
+	///
+	/// 0 if unknown.
+	std::size_t current_numa_node()noexcept;
+
+
+	/// \brief Node argument of numa_memory_policy to interleave the pages
+	///        over all nodes with memory
+	constexpr std::size_t numa_all_nodes = static_cast< std::size_t >(-1);
+
+	/// \brief Sets the memory policy of the calling thread for its lifetime
+	///
+	/// Pages the thread touches first while the object exists are placed on
+	/// the given node or interleaved over all nodes. Pages that are already
+	/// in use keep their place, so nothing is copied or migrated. On non
+	/// NUMA systems, for nodes without memory and if the kernel refuses,
+	/// nothing is changed.
+	class numa_memory_policy{
+	public:
+		/// \brief Prefer node for new pages, numa_all_nodes to interleave
+		explicit numa_memory_policy(std::size_t node)noexcept;
+
+		/// \brief Restore the default policy
+		~numa_memory_policy();
+
+		/// \brief Not copyable
+		numa_memory_policy(numa_memory_policy const&) = delete;
+
+		/// \brief Not copy-assignable
+		numa_memory_policy& operator=(numa_memory_policy const&) = delete;
+
+
+		/// \brief true if the policy of the thread was changed
+		bool active()const noexcept{
+			return active_;
+		}
+
+
+	private:
+		/// \brief true if the policy of the thread was changed
+		bool active_;
+	};
+
+
+	namespace detail{
+
+
+		/// \brief Nodes of a sysfs node list
+		struct numa_node_set{
+			/// \brief Count of nodes in the list
+			std::size_t count;
+
+			/// \brief Bit per node, 0 if a node number is 64 or greater
+			std::uint64_t mask;
+		};
+
+		/// \brief Parse a sysfs node list like "0-1,3"
+		///
+		/// An empty or invalid list is read as node 0 only.
+		numa_node_set parse_numa_node_list(std::string const& list)noexcept;
+
+
+	}
+
+
+}
+
+
+#endif
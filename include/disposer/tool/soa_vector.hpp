@@ -0,0 +1,179 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__soa_vector__hpp_INCLUDED_
+#define _disposer__tool__soa_vector__hpp_INCLUDED_
+
+#include "span.hpp"
+
+#include <boost/hana/accessors.hpp>
+#include <boost/hana/members.hpp>
+#include <boost/hana/for_each.hpp>
+#include <boost/hana/index_if.hpp>
+#include <boost/hana/transform.hpp>
+#include <boost/hana/equal.hpp>
+#include <boost/hana/front.hpp>
+#include <boost/hana/first.hpp>
+#include <boost/hana/second.hpp>
+#include <boost/hana/range.hpp>
+#include <boost/hana/size.hpp>
+#include <boost/hana/tuple.hpp>
+#include <boost/hana/at.hpp>
+
+#include <vector>
+
+
+namespace disposer{
+
+
+	namespace hana = boost::hana;
+
+
+	namespace detail{
+
+
+		template < typename Members >
+		struct soa_columns;
+
+		template < typename ... Members >
+		struct soa_columns< hana::tuple< Members ... > >{
+			using type = hana::tuple< std::vector< Members > ... >;
+		};
+
+
+	}
+
+
+	/// \brief Structure of arrays container for aggregate element types
+	///
+	/// T must be a Boost.Hana Struct (see BOOST_HANA_DEFINE_STRUCT) and
+	/// default constructible. Every member is stored in its own std::vector,
+	/// so a loop over one member reads contiguous memory and can be
+	/// vectorized. Use it as output type to pass a whole frame of elements
+	/// as one output element:
+	///
+	/// \code
+	/// struct point{
+	/// 	BOOST_HANA_DEFINE_STRUCT(point, (float, x), (float, y));
+	/// };
+	/// soa_vector< point > points;
+	/// for(auto& x: points.column(BOOST_HANA_STRING("x"))) x *= 2;
+	/// \endcode
+	template < typename T >
+	class soa_vector{
+	public:
+		/// \brief Element type
+		using value_type = T;
+
+		/// \brief Size type
+		using size_type = std::size_t;
+
+
+		/// \brief Count of elements
+		size_type size()const noexcept{
+			return hana::front(columns_).size();
+		}
+
+		/// \brief true if there are no elements
+		bool empty()const noexcept{
+			return hana::front(columns_).empty();
+		}
+
+		/// \brief Reserve memory in all columns
+		void reserve(size_type count){
+			hana::for_each(columns_,
+				[count](auto& column){ column.reserve(count); });
+		}
+
+		/// \brief Remove all elements
+		void clear()noexcept{
+			hana::for_each(columns_, [](auto& column){ column.clear(); });
+		}
+
+
+		/// \brief Append an element
+		void push_back(T const& value){
+			auto members = hana::members(value);
+			hana::for_each(indices, [this, &members](auto i){
+					columns_[i].push_back(std::move(members[i]));
+				});
+		}
+
+		/// \brief Assemble the element at position pos
+		T operator[](size_type pos)const{
+			T result{};
+			hana::for_each(indices, [this, &result, pos](auto i){
+					hana::second(accessors[i])(result) = columns_[i][pos];
+				});
+			return result;
+		}
+
+
+		/// \brief Contiguous view of the member with the given name
+		template < typename Key >
+		auto column(Key const& key)noexcept{
+			return span(columns_[index_of(key)]);
+		}
+
+		/// \brief Contiguous view of the member with the given name
+		template < typename Key >
+		auto column(Key const& key)const noexcept{
+			return span(columns_[index_of(key)]);
+		}
+
+
+		/// \brief Sum of the bytes in all columns, used by memory_size
+		std::size_t memory_size()const noexcept{
+			std::size_t result = sizeof(*this);
+			hana::for_each(columns_, [&result](auto const& column){
+					result += column.size() * sizeof(column[0]);
+				});
+			return result;
+		}
+
+
+	private:
+		/// \brief Make a span of the element type of a column
+		template < typename U >
+		static disposer::span< U > span(std::vector< U >& column)noexcept{
+			return column;
+		}
+
+		/// \brief Make a span of the element type of a column
+		template < typename U >
+		static disposer::span< U const > span(std::vector< U > const& column)
+		noexcept{
+			return column;
+		}
+
+		/// \brief Index of the member with the given name
+		template < typename Key >
+		static constexpr auto index_of(Key const& key)noexcept{
+			return hana::index_if(
+				hana::transform(accessors, hana::first),
+				hana::equal.to(key)).value();
+		}
+
+
+		/// \brief (name, accessor) pairs of the members of T
+		static constexpr auto accessors = hana::accessors< T >();
+
+		/// \brief Indices of the members of T
+		static constexpr auto indices = hana::make_range(
+			hana::size_c< 0 >, hana::size(accessors));
+
+		/// \brief One vector per member
+		typename detail::soa_columns<
+			decltype(hana::members(std::declval< T >())) >::type columns_;
+	};
+
+
+}
+
+
+#endif
@@ -0,0 +1,158 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__span__hpp_INCLUDED_
+#define _disposer__tool__span__hpp_INCLUDED_
+
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+
+
+namespace disposer{
+
+
+	/// \brief View to a contiguous sequence of objects
+	///
+	/// Subset of C++20 std::span with dynamic extent. Iterators are plain
+	/// pointers, so loops over a span can be auto-vectorized.
+	template < typename T >
+	class span{
+	public:
+		/// \brief Element type
+		using element_type = T;
+
+		/// \brief Element type without const and volatile
+		using value_type = std::remove_cv_t< T >;
+
+		/// \brief Size type
+		using size_type = std::size_t;
+
+		/// \brief Pointer type
+		using pointer = T*;
+
+		/// \brief Reference type
+		using reference = T&;
+
+		/// \brief Random access iterator
+		using iterator = T*;
+
+		/// \brief Reverse random access iterator
+		using reverse_iterator = std::reverse_iterator< iterator >;
+
+
+		/// \brief Empty span
+		constexpr span()noexcept
+			: data_(nullptr)
+			, size_(0) {}
+
+		/// \brief Span of size elements beginning at data
+		constexpr span(T* data, size_type size)noexcept
+			: data_(data)
+			, size_(size) {}
+
+		/// \brief Span of [first, last)
+		constexpr span(T* first, T* last)noexcept
+			: data_(first)
+			, size_(static_cast< size_type >(last - first)) {}
+
+		/// \brief Span over a contiguous container, e.g. std::vector
+		template < typename Container, typename = std::enable_if_t<
+			std::is_convertible_v< decltype(std::declval< Container& >()
+				.data()), T* > > >
+		constexpr span(Container& container)noexcept
+			: data_(container.data())
+			, size_(container.size()) {}
+
+		/// \brief Conversion from span< U > to span< U const >
+		template < typename U, typename = std::enable_if_t<
+			std::is_convertible_v< U(*)[], T(*)[] > > >
+		constexpr span(span< U > const& other)noexcept
+			: data_(other.data())
+			, size_(other.size()) {}
+
+
+		/// \brief Pointer to the first element
+		constexpr T* data()const noexcept{ return data_; }
+
+		/// \brief Count of elements
+		constexpr size_type size()const noexcept{ return size_; }
+
+		/// \brief Size in bytes
+		constexpr size_type size_bytes()const noexcept{
+			return size_ * sizeof(T);
+		}
+
+		/// \brief true if the span has no elements
+		constexpr bool empty()const noexcept{ return size_ == 0; }
+
+
+		/// \brief Access specified element
+		constexpr T& operator[](size_type pos)const noexcept{
+			return data_[pos];
+		}
+
+		/// \brief First element
+		constexpr T& front()const noexcept{ return data_[0]; }
+
+		/// \brief Last element
+		constexpr T& back()const noexcept{ return data_[size_ - 1]; }
+
+
+		/// \brief Span of the first count elements
+		constexpr span first(size_type count)const noexcept{
+			return {data_, count};
+		}
+
+		/// \brief Span of the last count elements
+		constexpr span last(size_type count)const noexcept{
+			return {data_ + (size_ - count), count};
+		}
+
+		/// \brief Span of count elements beginning at offset
+		constexpr span subspan(size_type offset, size_type count)
+		const noexcept{
+			return {data_ + offset, count};
+		}
+
+		/// \brief Span of all elements beginning at offset
+		constexpr span subspan(size_type offset)const noexcept{
+			return {data_ + offset, size_ - offset};
+		}
+
+
+		/// \brief Iterator to the beginning
+		constexpr iterator begin()const noexcept{ return data_; }
+
+		/// \brief Iterator to the end
+		constexpr iterator end()const noexcept{ return data_ + size_; }
+
+		/// \brief Reverse iterator to the beginning
+		constexpr reverse_iterator rbegin()const noexcept{
+			return reverse_iterator(end());
+		}
+
+		/// \brief Reverse iterator to the end
+		constexpr reverse_iterator rend()const noexcept{
+			return reverse_iterator(begin());
+		}
+
+
+	private:
+		/// \brief Pointer to the first element
+		T* data_;
+
+		/// \brief Count of elements
+		size_type size_;
+	};
+
+
+}
+
+
+#endif
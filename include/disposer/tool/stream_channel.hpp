@@ -0,0 +1,153 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#ifndef _disposer__tool__stream_channel__hpp_INCLUDED_
+#define _disposer__tool__stream_channel__hpp_INCLUDED_
+
+#include "managed_blocking.hpp"
+
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <stdexcept>
+#include <deque>
+
+
+namespace disposer{
+
+
+	/// \brief Thrown by stream_channel::pop if the producer failed
+	struct stream_aborted: std::runtime_error{
+		stream_aborted()
+			: std::runtime_error("stream was aborted by its producer") {}
+	};
+
+
+	/// \brief Bounded channel between the producers and one consumer
+	///
+	/// push() blocks while the channel is full, pop() blocks while it is
+	/// empty and not closed. Multiple threads may push concurrently, only one
+	/// thread must pop.
+	template < typename T >
+	class stream_channel{
+	public:
+		/// \brief Constructor
+		stream_channel(std::size_t capacity)noexcept
+			: capacity_(capacity > 0 ? capacity : 1) {}
+
+		/// \brief Channels are not copyable
+		stream_channel(stream_channel const&) = delete;
+
+		/// \brief Channels are not copy-assignable
+		stream_channel& operator=(stream_channel const&) = delete;
+
+
+		/// \brief Add an element, blocks while the channel is full
+		///
+		/// Returns false if the consumer is gone, the element is dropped
+		/// in this case.
+		template < typename ... Args >
+		bool emplace(Args&& ... args){
+			std::unique_lock lock(mutex_);
+			auto const ready = [this]{
+					return abandoned_ || closed_ || data_.size() < capacity_;
+				};
+			if(!ready()){
+				managed_blocking blocking;
+				not_full_.wait(lock, ready);
+			}
+
+			if(abandoned_ || closed_) return false;
+
+			data_.emplace_back(static_cast< Args&& >(args) ...);
+			lock.unlock();
+			not_empty_.notify_one();
+			return true;
+		}
+
+		/// \brief Get the next element, blocks while the channel is empty
+		///
+		/// Returns an empty optional after the producer closed the channel
+		/// and all elements have been consumed. Throws stream_aborted if the
+		/// producer closed the channel with failure.
+		std::optional< T > pop(){
+			std::unique_lock lock(mutex_);
+			auto const ready = [this]{
+					return closed_ || !data_.empty();
+				};
+			if(!ready()){
+				managed_blocking blocking;
+				not_empty_.wait(lock, ready);
+			}
+
+			if(failed_) throw stream_aborted();
+			if(data_.empty()) return {};
+
+			std::optional< T > result(std::move(data_.front()));
+			data_.pop_front();
+			lock.unlock();
+			not_full_.notify_one();
+			return result;
+		}
+
+		/// \brief Called by the producer after it finished
+		///
+		/// Only the first call has an effect.
+		void close(bool const success)noexcept{
+			std::unique_lock lock(mutex_);
+			if(closed_) return;
+			closed_ = true;
+			failed_ = !success;
+			lock.unlock();
+			not_empty_.notify_all();
+			not_full_.notify_all();
+		}
+
+		/// \brief Called by the consumer if it will not pop anymore
+		///
+		/// All remaining and all following elements are dropped.
+		void abandon()noexcept{
+			std::unique_lock lock(mutex_);
+			abandoned_ = true;
+			data_.clear();
+			lock.unlock();
+			not_full_.notify_all();
+		}
+
+
+	private:
+		/// \brief Maximum count of buffered elements
+		std::size_t const capacity_;
+
+		/// \brief Buffered elements
+		std::deque< T > data_;
+
+		/// \brief true after close()
+		bool closed_ = false;
+
+		/// \brief true if close() was called with failure
+		bool failed_ = false;
+
+		/// \brief true after abandon()
+		bool abandoned_ = false;
+
+		/// \brief Protects all members
+		std::mutex mutex_;
+
+		/// \brief Signaled after push() and close()
+		std::condition_variable not_empty_;
+
+		/// \brief Signaled after pop(), close() and abandon()
+		std::condition_variable not_full_;
+	};
+
+
+}
+
+
+#endif
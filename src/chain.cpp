@@ -12,11 +12,16 @@
 
 #include <disposer/config/create_chain_modules.hpp>
 
+#include <disposer/tool/numa.hpp>
+
 #include <logsys/stdlogb.hpp>
 #include <logsys/log.hpp>
 
+#include <algorithm>
 #include <numeric>
+#include <optional>
 #include <future>
+#include <chrono>
 
 
 namespace disposer{
@@ -26,12 +31,28 @@ namespace disposer{
 		module_maker_list const& module_makers,
 		component_module_makers_list& component_module_makers,
 		types::embedded_config::chain const& config_chain,
-		id_generator& generate_id
+		id_generator& generate_id,
+		memory_usage& system_memory,
+		executor& executor
 	)
 		: name(config_chain.name)
-		, modules_(create_chain_modules(
-			module_makers, component_module_makers, config_chain))
+		, parameters_(make_chain_parameters(config_chain))
+		, replicas_([&]{
+				std::deque< replica > replicas;
+				for(std::size_t i = 0; i < parameters_.replicas; ++i){
+					replicas.emplace_back(create_chain_modules(
+						module_makers, component_module_makers, config_chain,
+						parameters_));
+				}
+				return replicas;
+			}())
 		, generate_id_(generate_id)
+		, memory_(&system_memory)
+		, executor_(executor)
+		, scheduling_(parameters_.priority, parameters_.weight,
+			parameters_.deadline)
+		, exec_times_(std::make_unique< moving_average[] >(
+			replicas_.front().modules.modules.size()))
 		, enable_count_(0)
 		, exec_calls_count_(0) {}
 
@@ -66,6 +87,61 @@ namespace disposer{
 		};
 
 
+		/// \brief Decrements the count of running execs of a replica
+		class running_guard{
+		public:
+			running_guard(std::atomic< std::size_t >& running)noexcept
+				: running_(running) {}
+
+			~running_guard(){
+				--running_;
+			}
+
+		private:
+			std::atomic< std::size_t >& running_;
+		};
+
+
+		/// \brief Delays the return of an exec until all execs with a
+		///        lower exec id returned
+		class result_sequencer{
+		public:
+			result_sequencer(
+				bool const active,
+				std::size_t const exec_id,
+				std::size_t& next_result,
+				std::mutex& mutex,
+				std::condition_variable& cv
+			)noexcept
+				: active_(active)
+				, exec_id_(exec_id)
+				, next_result_(next_result)
+				, mutex_(mutex)
+				, cv_(cv) {}
+
+			~result_sequencer(){
+				if(!active_) return;
+
+				std::unique_lock lock(mutex_);
+				auto const ready = [this]{ return next_result_ == exec_id_; };
+				if(!ready()){
+					managed_blocking blocking;
+					cv_.wait(lock, ready);
+				}
+				++next_result_;
+				lock.unlock();
+				cv_.notify_all();
+			}
+
+		private:
+			bool const active_;
+			std::size_t const exec_id_;
+			std::size_t& next_result_;
+			std::mutex& mutex_;
+			std::condition_variable& cv_;
+		};
+
+
 		/// \brief A module and its execution data
 		class chain_exec_module_data{
 		public:
@@ -216,7 +292,7 @@ namespace disposer{
 			/// \brief List of modules and there execution data
 			std::vector< chain_exec_module_data > modules;
 
-			/// \brief Pointers to all modules without active inputs
+			/// \brief Pointers to all modules without precursors
 			std::vector< chain_exec_module_data* > const start_modules;
 
 			/// \brief Memory for the async executions of the starter modules
@@ -228,10 +304,343 @@ namespace disposer{
 		};
 
 
-		chain_exec_module_list make_exec_modules(
+		/// \brief Run all modules one after another on the calling thread
+		///
+		/// The modules are in topological order, so every module runs after
+		/// its precursors. If a module failed, all modules that depend on it
+		/// are only cleaned up.
+		class chain_inline_module_list{
+		public:
+			chain_inline_module_list(
+				chain_module_list const& module_list,
+				std::vector< exec_module_ptr >&& list
+			)
+				: module_list_(module_list)
+				, modules_(std::move(list))
+				, precursor_failed_(modules_.size(), false) {}
+
+			bool exec()noexcept{
+				auto success = true;
+				for(std::size_t i = 0; i < modules_.size(); ++i){
+					auto& module = modules_[i];
+
+					auto const module_success =
+						!precursor_failed_[i] && module->exec();
+
+					module->cleanup();
+
+					if(!module_success){
+						success = false;
+						auto const& data = module_list_.modules[i];
+						for(auto const next: data.next_indexes){
+							precursor_failed_[next] = true;
+						}
+					}
+				}
+				return success;
+			}
+
+		private:
+			/// \brief The chains modules
+			chain_module_list const& module_list_;
+
+			/// \brief The exec modules in topological order
+			std::vector< exec_module_ptr > modules_;
+
+			/// \brief true if at least one precursor failed
+			std::vector< bool > precursor_failed_;
+		};
+
+
+		/// \brief Run the modules on the workers of the system executor
+		///
+		/// A module starts when all its precursors finished. The worker that
+		/// finished the last precursor runs one of the ready modules itself.
+		/// Further ready modules are posted to the executor if a worker is
+		/// idle and their average exec time is above the average dispatch
+		/// time, otherwise the same worker runs them too. Modules that use
+		/// streams are always posted, they must run in parallel to their
+		/// partner.
+		///
+		/// On NUMA systems the output data is first touched on the node of
+		/// its expected consumer while the producer writes it, see
+		/// output_node().
+		class chain_adaptive_module_list{
+		public:
+			chain_adaptive_module_list(
+				chain_module_list const& module_list,
+				std::vector< exec_module_ptr >&& list,
+				executor& executor,
+				scheduling_class& scheduling,
+				executor::time_point const deadline,
+				moving_average* exec_times,
+				moving_average& dispatch_time
+			)
+				: module_list_(module_list)
+				, modules_(std::move(list))
+				, data_(std::make_unique< module_data[] >(modules_.size()))
+				, executor_(executor)
+				, scheduling_(scheduling)
+				, deadline_(deadline)
+				, exec_times_(exec_times)
+				, dispatch_time_(dispatch_time)
+				, start_modules_(module_list.start_indexes)
+				, remaining_(modules_.size())
+				, success_(true)
+				, done_(modules_.empty())
+			{
+				for(std::size_t i = 0; i < modules_.size(); ++i){
+					auto const& data = module_list_.modules[i];
+					data_[i].precursor_count = data.precursor_count;
+					data_[i].ready.reserve(data.next_indexes.size());
+				}
+			}
+
+			bool exec()noexcept{
+				schedule(start_modules_);
+
+				std::unique_lock lock(mutex_);
+				if(!done_){
+					managed_blocking blocking;
+					cv_.wait(lock, [this]{ return done_; });
+				}
+
+				return success_;
+			}
+
+		private:
+			using clock = std::chrono::steady_clock;
+
+			/// \brief Execution state of a module
+			struct module_data{
+				/// \brief Count of precursors that are not finished
+				std::atomic< std::size_t > precursor_count;
+
+				/// \brief true if at least one precursor failed
+				std::atomic< bool > precursor_failed{false};
+
+				/// \brief Worker that ran the module, no_worker if none
+				std::atomic< std::size_t > worker{executor::no_worker};
+
+				/// \brief NUMA node the module ran on
+				std::atomic< std::size_t > node{0};
+
+				/// \brief Successors that became ready by this module
+				///
+				/// Memory is reserved in the constructor, so run() doesn't
+				/// allocate.
+				std::vector< std::size_t > ready;
+			};
+
+			/// \brief Exec or skip module i, then schedule its successors
+			void run(std::size_t const i)noexcept{
+				auto& module = modules_[i];
+
+				auto success = false;
+				if(!data_[i].precursor_failed){
+					data_[i].worker = executor_.current_worker();
+
+					std::optional< numa_memory_policy > policy;
+					if(numa_node_count() > 1){
+						data_[i].node = current_numa_node();
+						auto const node = output_node(i);
+						if(node != data_[i].node) policy.emplace(node);
+					}
+
+					auto const start = clock::now();
+					success = module->exec();
+					exec_times_[i].add(clock::now() - start);
+				}
+
+				module->cleanup();
+
+				if(!success) success_ = false;
+
+				auto& ready = data_[i].ready;
+				for(auto const next: module_list_.modules[i].next_indexes){
+					if(!success) data_[next].precursor_failed = true;
+					if(--data_[next].precursor_count == 0){
+						ready.push_back(next);
+					}
+				}
+
+				schedule(ready);
+
+				if(--remaining_ == 0){
+					std::lock_guard lock(mutex_);
+					done_ = true;
+					cv_.notify_all();
+				}
+			}
+
+			/// \brief Post or run the given ready modules
+			void schedule(std::vector< std::size_t >& ready)noexcept{
+				// the continuation should read data this worker produced
+				auto const self = executor_.current_worker();
+				if(self != executor::no_worker){
+					auto const local = std::find_if(ready.begin(), ready.end(),
+						[this, self](std::size_t const i){
+							return !module_list_.modules[i].uses_stream
+								&& preferred_worker(i) == self;
+						});
+					if(local != ready.end()){
+						std::rotate(ready.begin(), local, local + 1);
+					}
+				}
+
+				// move the modules to run in this thread to the front
+				std::size_t keep = 0;
+				for(auto const i: ready){
+					auto const uses_stream =
+						module_list_.modules[i].uses_stream;
+					auto const continuation = keep == 0 && !uses_stream;
+					if(!continuation && (uses_stream || worth_dispatch(i))){
+						post(i);
+					}else{
+						ready[keep++] = i;
+					}
+				}
+
+				for(std::size_t k = 0; k < keep; ++k){
+					run(ready[k]);
+				}
+			}
+
+			/// \brief true if module i should run in parallel
+			bool worth_dispatch(std::size_t const i)const noexcept{
+				if(executor_.idle_worker_count() == 0) return false;
+				auto const& exec_time = exec_times_[i];
+				if(exec_time.empty()) return true;
+				return exec_time.get() > dispatch_time_.get();
+			}
+
+			/// \brief Worker that ran the producer of module i with the
+			///        longest average exec time
+			///
+			/// Its output is most likely still in the cache of that worker.
+			/// The producers are taken from the unreduced producer list, a
+			/// direct producer may have no edge to module i.
+			std::size_t preferred_worker(std::size_t const i)const noexcept{
+				auto const producer = preferred_producer(i);
+				return producer < modules_.size()
+					? data_[producer].worker.load() : executor::no_worker;
+			}
+
+			/// \brief The producer of module i that ran on a worker with the
+			///        longest average exec time, modules_.size() if none
+			std::size_t preferred_producer(std::size_t const i)const noexcept{
+				auto result = modules_.size();
+				std::chrono::nanoseconds max_time(-1);
+				for(auto const j: module_list_.modules[i].producer_indexes){
+					if(data_[j].worker == executor::no_worker) continue;
+					auto const time = exec_times_[j].get();
+					if(time > max_time){
+						max_time = time;
+						result = j;
+					}
+				}
+				return result;
+			}
+
+			/// \brief NUMA node for the output data of module i
+			///
+			/// Called by the worker that runs module i. Data of multiple
+			/// consumers is interleaved over all nodes, the consumers may be
+			/// posted to workers on different nodes. A single consumer is
+			/// posted to the worker of its preferred producer, so its data
+			/// goes to the node that producer ran on. Without consumers the
+			/// data stays on the node of module i.
+			std::size_t output_node(std::size_t const i)const noexcept{
+				auto const& consumers =
+					module_list_.modules[i].consumer_indexes;
+				if(consumers.size() > 1) return numa_all_nodes;
+				if(consumers.empty()) return data_[i].node;
+
+				auto const producer = preferred_producer(consumers.front());
+				return producer < modules_.size()
+					? data_[producer].node.load() : data_[i].node.load();
+			}
+
+			/// \brief Run module i in a worker thread
+			///
+			/// If the executor can't take the module, it fails and the
+			/// modules that depend on it are skipped. Running it here could
+			/// block forever, e.g. on a stream partner that is not
+			/// scheduled yet.
+			void post(std::size_t const i)noexcept{
+				try{
+					executor_.post([this, i, posted = clock::now()]{
+							dispatch_time_.add(clock::now() - posted);
+							run(i);
+						}, scheduling_, deadline_, preferred_worker(i));
+				}catch(...){
+					auto const& module = *module_list_.modules[i].module;
+					logsys::log([&module](logsys::stdlogb& os){
+							os << "module(" << module.number << ":"
+								<< module.type_name
+								<< ") failed because it could not be posted "
+								"to the executor";
+						});
+
+					data_[i].precursor_failed = true;
+					run(i);
+				}
+			}
+
+
+			/// \brief The chains modules
+			chain_module_list const& module_list_;
+
+			/// \brief The exec modules in order of module_list_
+			std::vector< exec_module_ptr > modules_;
+
+			/// \brief Execution state per module
+			std::unique_ptr< module_data[] > data_;
+
+			/// \brief Worker threads of the system
+			executor& executor_;
+
+			/// \brief Scheduling class of the chain
+			scheduling_class& scheduling_;
+
+			/// \brief Deadline of this exec
+			executor::time_point const deadline_;
+
+			/// \brief Average exec time per module
+			moving_average* const exec_times_;
+
+			/// \brief Average time between post and start of a module
+			moving_average& dispatch_time_;
+
+			/// \brief Modules without precursors
+			std::vector< std::size_t > start_modules_;
+
+			/// \brief Count of modules that are not finished
+			std::atomic< std::size_t > remaining_;
+
+			/// \brief false if at least one module failed
+			std::atomic< bool > success_;
+
+			/// \brief Protects done_
+			std::mutex mutex_;
+
+			/// \brief Signaled when all modules are finished
+			std::condition_variable cv_;
+
+			/// \brief true if all modules are finished
+			bool done_;
+		};
+
+
+		std::vector< exec_module_ptr > make_exec_module_list(
 			chain_module_list const& module_list,
 			std::size_t const id,
-			std::size_t const exec_id
+			std::size_t const exec_id,
+			memory_usage& memory,
+			executor& executor,
+			scheduling_class& scheduling,
+			exec_arguments& arguments,
+			exec_results& results
 		){
 			std::vector< exec_module_ptr > list;
 			list.reserve(module_list.modules.size());
@@ -240,43 +649,230 @@ namespace disposer{
 			for(auto const& data: module_list.modules){
 				list.push_back(data.module
 					->make_exec_module(id, exec_id, output_map));
+				list.back()->set_executor(executor, scheduling);
+				list.back()->set_arguments(arguments);
+				list.back()->set_results(results);
+			}
+
+			for(auto const& [output, exec_output]: output_map){
+				(void)output; // silance GCC
+				exec_output->set_memory_usage(&memory);
+			}
+
+			return list;
+		}
+
+
+
+		/// \brief Create the detail record of an exec and connect its
+		///        entries to the exec modules
+		std::shared_ptr< exec_details > make_exec_details(
+			chain_module_list const& module_list,
+			std::vector< exec_module_ptr > const& list,
+			std::chrono::steady_clock::time_point const start
+		){
+			auto result = std::make_shared< exec_details >();
+			result->start = start;
+			result->modules.reserve(list.size());
+			for(auto const& data: module_list.modules){
+				result->modules.push_back(module_exec_info{
+					data.module->number, data.module->type_name});
+			}
+
+			for(std::size_t i = 0; i < list.size(); ++i){
+				list[i]->set_exec_details(&result->modules[i]);
 			}
 
-			return chain_exec_module_list(module_list, std::move(list));
+			return result;
 		}
 
 
 	}
 
 
+	std::pair< chain::replica&, std::size_t > chain::select_replica(
+		std::size_t const exec_id
+	){
+		auto const count = replicas_.size();
+		if(parameters_.distribution == chain_distribution::round_robin){
+			// every replica gets consecutive exec ids in the order of the
+			// chain exec ids
+			auto& result = replicas_[exec_id % count];
+			++result.running;
+			return {result, exec_id / count};
+		}
+
+		std::lock_guard lock(select_mutex_);
+		auto& result = *std::min_element(replicas_.begin(), replicas_.end(),
+			[](replica const& a, replica const& b){
+				return a.running < b.running;
+			});
+		++result.running;
+		return {result, result.generate_exec_id()};
+	}
+
+
 	exec_info chain::exec(){
+		return exec(parameters_.details);
+	}
+
+
+	exec_info chain::exec(bool const details){
+		return exec(exec_arguments(), details);
+	}
+
+
+	exec_info chain::exec(exec_arguments arguments){
+		return exec(std::move(arguments), parameters_.details);
+	}
+
+
+	exec_info chain::exec(exec_arguments arguments, bool const details){
 		if(enable_count_ == 0){
 			throw std::logic_error("chain(" + name + ") is not enabled");
 		}
 
 		exec_call_manager lock(exec_calls_count_, enable_cv_);
 
+		// the deadline counts from the exec() call
+		auto const start = std::chrono::steady_clock::now();
+
+		// delay the exec while too much output data is in flight
+		memory_.wait_for_budget();
+
 		// generate a new id for the exec
 		std::size_t const id = generate_id_();
 		std::size_t const exec_id = generate_exec_id_();
 
+		// must be constructed before any exception can occur
+		result_sequencer sequencer(parameters_.in_order, exec_id,
+			next_result_, result_mutex_, result_cv_);
+
+		auto const selected = select_replica(exec_id);
+		auto const& modules = selected.first.modules;
+		std::size_t const module_exec_id = selected.second;
+		running_guard const running(selected.first.running);
+
 		// exec any module, call cleanup instead if the module throw
 		return logsys::log(
 			[this, id](logsys::stdlogb& os){
 				os << "id(" << id << ") chain(" << name << ")";
-			}, [this, id, exec_id]{
-				auto modules = logsys::log(
+			}, [this, id, exec_id, module_exec_id, &modules, start, details,
+				&arguments
+			]{
+				exec_results results;
+				auto list = logsys::log(
 					[this, id](logsys::stdlogb& os){
 						os << "id(" << id << ") chain(" << name << ") prepared";
-					}, [this, id, exec_id]{
-						return make_exec_modules(modules_, id, exec_id);
+					}, [this, id, module_exec_id, &modules, &arguments,
+						&results
+					]{
+						return make_exec_module_list(modules, id,
+							module_exec_id, memory_, executor_, scheduling_,
+							arguments, results);
 					});
 
-				return exec_info{modules.exec(), id, exec_id};
+				auto const result = details
+					? make_exec_details(modules, list, start) : nullptr;
+
+				auto const success = [&]{
+						switch(parameters_.executor){
+							case chain_executor::parallel: break;
+							case chain_executor::caller_thread:{
+								chain_inline_module_list exec_list(
+									modules, std::move(list));
+								return exec_list.exec();
+							}
+							case chain_executor::adaptive:{
+								auto const deadline =
+									scheduling_.deadline.count() > 0
+									? start + scheduling_.deadline
+									: executor::time_point::max();
+								chain_adaptive_module_list exec_list(
+									modules, std::move(list), executor_,
+									scheduling_, deadline, exec_times_.get(),
+									dispatch_time_);
+								return exec_list.exec();
+							}
+						}
+
+						chain_exec_module_list exec_list(
+							modules, std::move(list));
+						return exec_list.exec();
+					}();
+
+				if(result) result->end = std::chrono::steady_clock::now();
+				return exec_info{success, id, exec_id, result,
+					std::move(results)};
 			});
 	}
 
 
+	std::vector< module_memo_metrics > chain::memoization()const{
+		std::vector< module_memo_metrics > result;
+		for(std::size_t i = 0; i < replicas_.size(); ++i){
+			for(auto const& data: replicas_[i].modules.modules){
+				auto const& module = *data.module;
+				if(auto metrics = module.memoization()){
+					result.push_back(module_memo_metrics{
+						i, module.number, module.type_name, *metrics});
+				}
+			}
+		}
+		return result;
+	}
+
+
+	void chain::enable_modules(chain_module_list const& modules){
+		std::size_t i = 0;
+		try{
+			// enable all modules
+			for(; i < modules.modules.size(); ++i){
+				auto& module = modules.modules[i].module;
+				logsys::log([this, &module](logsys::stdlogb& os){
+						os << "chain(" << name << ") module("
+							<< module->number << ":"
+							<< module->type_name
+							<< ") enabled";
+					}, [&module]{
+						module->enable();
+					});
+			}
+		}catch(...){
+			// disable all modules until the one who throw
+			for(std::size_t j = 0; j < i; ++j){
+				auto& module = modules.modules[j].module;
+				logsys::log([this, i, &module, &modules](logsys::stdlogb& os){
+						os << "chain(" << name << ") module("
+							<< module->number
+							<< ") disabled because of exception "
+							<< "while enable module("
+							<< modules.modules[i].module->number
+							<< ")";
+					}, [&module]{
+						module->disable();
+					});
+			}
+
+			// rethrow exception
+			throw;
+		}
+	}
+
+	void chain::disable_modules(chain_module_list const& modules)noexcept{
+		for(std::size_t i = 0; i < modules.modules.size(); ++i){
+			auto& module = modules.modules[i].module;
+			logsys::log([this, &module](logsys::stdlogb& os){
+					os << "chain(" << name << ") module("
+						<< module->number << ":"
+						<< module->type_name << ") disabled";
+				}, [&module]{
+					module->disable();
+				});
+		}
+	}
+
+
 	void chain::enable(){
 		std::unique_lock< std::mutex > lock(enable_mutex_);
 
@@ -288,32 +884,13 @@ namespace disposer{
 				[this]{
 					std::size_t i = 0;
 					try{
-						// enable all modules
-						for(; i < modules_.modules.size(); ++i){
-							auto& module = modules_.modules[i].module;
-							logsys::log([this, &module](logsys::stdlogb& os){
-									os << "chain(" << name << ") module("
-										<< module->number << ":"
-										<< module->type_name
-										<< ") enabled";
-								}, [&module]{
-									module->enable();
-								});
+						for(; i < replicas_.size(); ++i){
+							enable_modules(replicas_[i].modules);
 						}
 					}catch(...){
-						// disable all modules until the one who throw
+						// disable all replicas that are already enabled
 						for(std::size_t j = 0; j < i; ++j){
-							auto& module = modules_.modules[j].module;
-							logsys::log([this, i, &module](logsys::stdlogb& os){
-									os << "chain(" << name << ") module("
-										<< module->number
-										<< ") disabled because of exception "
-										<< "while enable module("
-										<< modules_.modules[i].module->number
-										<< ")";
-								}, [&module]{
-									module->disable();
-								});
+							disable_modules(replicas_[j].modules);
 						}
 
 						// rethrow exception
@@ -340,16 +917,8 @@ namespace disposer{
 					os << "chain(" << name << ") disabled";
 				},
 				[this]{
-					// disable all modules
-					for(std::size_t i = 0; i < modules_.modules.size(); ++i){
-						auto& module = modules_.modules[i].module;
-						logsys::log([this, &module](logsys::stdlogb& os){
-								os << "chain(" << name << ") module("
-									<< module->number << ":"
-									<< module->type_name << ") disabled";
-							}, [&module]{
-								module->disable();
-							});
+					for(auto& replica: replicas_){
+						disable_modules(replica.modules);
 					}
 				});
 		}
@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <disposer/config/chain_parameters.hpp>
+
+#include <stdexcept>
+#include <charconv>
+#include <limits>
+
+
+namespace disposer{
+
+
+	namespace{
+
+
+		chain_executor parse_executor(
+			std::string const& chain,
+			std::string const& value
+		){
+			if(value == "parallel") return chain_executor::parallel;
+			if(value == "inline") return chain_executor::caller_thread;
+			if(value == "adaptive") return chain_executor::adaptive;
+
+			throw std::logic_error("in chain(" + chain
+				+ "): parameter executor has invalid value '" + value
+				+ "', valid values are 'parallel', 'inline' and 'adaptive'");
+		}
+
+		template < typename T >
+		T parse_integer(
+			std::string const& chain,
+			std::string const& key,
+			std::string const& value,
+			T const min
+		){
+			T result = 0;
+			auto const end = value.data() + value.size();
+			auto const [ptr, ec] = std::from_chars(value.data(), end, result);
+			if(ec != std::errc() || ptr != end || result < min){
+				throw std::logic_error("in chain(" + chain
+					+ "): parameter " + key + " has invalid value '" + value
+					+ "', valid values are integers"
+					+ (min != std::numeric_limits< T >::min()
+						? " >= " + std::to_string(min) : std::string()));
+			}
+			return result;
+		}
+
+		chain_distribution parse_distribution(
+			std::string const& chain,
+			std::string const& value
+		){
+			if(value == "round_robin") return chain_distribution::round_robin;
+			if(value == "least_loaded") return chain_distribution::least_loaded;
+
+			throw std::logic_error("in chain(" + chain
+				+ "): parameter distribution has invalid value '" + value
+				+ "', valid values are 'round_robin' and 'least_loaded'");
+		}
+
+		bool parse_bool(
+			std::string const& chain,
+			std::string const& key,
+			std::string const& value
+		){
+			if(value == "true") return true;
+			if(value == "false") return false;
+
+			throw std::logic_error("in chain(" + chain
+				+ "): parameter " + key + " has invalid value '" + value
+				+ "', valid values are 'true' and 'false'");
+		}
+
+
+	}
+
+
+	chain_parameters make_chain_parameters(
+		types::embedded_config::chain const& config_chain
+	){
+		chain_parameters result;
+
+		// keys of the scheduling class
+		std::string scheduling;
+
+		for(auto const& [key, value]: config_chain.parameters){
+			if(key == "executor"){
+				result.executor = parse_executor(config_chain.name, value);
+			}else if(key == "replicas"){
+				result.replicas = parse_integer< std::size_t >(
+					config_chain.name, key, value, 1);
+			}else if(key == "distribution"){
+				result.distribution =
+					parse_distribution(config_chain.name, value);
+			}else if(key == "in_order"){
+				result.in_order = parse_bool(config_chain.name, key, value);
+			}else if(key == "priority"){
+				result.priority = parse_integer< int >(config_chain.name, key,
+					value, std::numeric_limits< int >::min());
+				scheduling = key;
+			}else if(key == "weight"){
+				result.weight = parse_integer< std::size_t >(
+					config_chain.name, key, value, 1);
+				scheduling = key;
+			}else if(key == "deadline"){
+				result.deadline = std::chrono::milliseconds(
+					parse_integer< std::chrono::milliseconds::rep >(
+						config_chain.name, key, value, 0));
+				scheduling = key;
+			}else if(key == "details"){
+				result.details = parse_bool(config_chain.name, key, value);
+			}else{
+				throw std::logic_error("in chain(" + config_chain.name
+					+ "): unknown parameter '" + key + "'");
+			}
+		}
+
+		// only the adaptive executor runs the modules on the system
+		// executor, the others would ignore the scheduling class
+		if(!scheduling.empty()
+			&& result.executor != chain_executor::adaptive)
+		{
+			throw std::logic_error("in chain(" + config_chain.name
+				+ "): parameter " + scheduling
+				+ " requires executor = adaptive");
+		}
+
+		return result;
+	}
+
+
+}
@@ -31,6 +31,13 @@ namespace disposer{ namespace{
 	/// \brief Map from a variable name to an output
 	using variables_map = std::map< std::string, output_t >;
 
+	/// \brief Connection of a stream capable output to its only input
+	struct stream_edge{
+		std::size_t producer;
+		std::size_t consumer;
+		output_base* output;
+	};
+
 	module_ptr create_module(
 		module_maker_list const& module_makers,
 		component_module_makers_list& component_module_makers,
@@ -107,6 +114,246 @@ namespace disposer{ namespace{
 	}
 
 
+	/// \brief Decide for every stream capable connection whether it streams
+	///
+	/// A stream connection is no edge of the dependency graph, its consumer
+	/// runs concurrently with its producer. If the consumer depends on the
+	/// producer by any other path too, it waits for the producer, while the
+	/// producer waits for the consumer to empty the bounded channel. Such
+	/// outputs fall back to normal outputs. So do the inputs of memoized
+	/// modules, their output cache needs all elements before the exec.
+	void decide_streams(
+		std::string_view const chain,
+		std::vector< chain_module_data >& modules,
+		std::vector< stream_edge > const& edges
+	){
+		if(edges.empty()) return;
+
+		auto const count = modules.size();
+
+		// all edges including the stream connections
+		std::vector< std::vector< std::size_t > > successors(count);
+		for(std::size_t i = 0; i < count; ++i){
+			successors[i] = modules[i].next_indexes;
+		}
+		for(auto const& edge: edges){
+			successors[edge.producer].push_back(edge.consumer);
+		}
+
+		// reachable[i][j]: module j is reachable from module i by a path
+		// of length >= 1, built in reverse topological order
+		std::vector< std::vector< bool > > reachable(
+			count, std::vector< bool >(count, false));
+		for(std::size_t i = count; i-- > 0;){
+			for(auto const next: successors[i]){
+				reachable[i][next] = true;
+				for(std::size_t j = next + 1; j < count; ++j){
+					if(reachable[next][j]) reachable[i][j] = true;
+				}
+			}
+		}
+
+		for(auto const& edge: edges){
+			auto const& next = successors[edge.producer];
+			auto const direct = std::count(
+				next.begin(), next.end(), edge.consumer);
+			auto const indirect = std::any_of(next.begin(), next.end(),
+				[&](std::size_t const i){
+					return i != edge.consumer && reachable[i][edge.consumer];
+				});
+
+			// the output cache hashes the whole input before the exec
+			auto const memoized =
+				modules[edge.consumer].module->memoization().has_value();
+
+			if(direct == 1 && !indirect && !memoized){
+				modules[edge.producer].uses_stream = true;
+				modules[edge.consumer].uses_stream = true;
+				continue;
+			}
+
+			logsys::log([chain, &modules, &edge, memoized](
+					logsys::stdlogb& os
+				){
+					auto const& producer = *modules[edge.producer].module;
+					auto const& consumer = *modules[edge.consumer].module;
+					os << "chain(" << chain << ") module("
+						<< consumer.number << ":" << consumer.type_name
+						<< ") ";
+					if(memoized){
+						os << "is memoized";
+					}else{
+						os << "depends on module("
+							<< producer.number << ":" << producer.type_name
+							<< ") by another path";
+					}
+					os << ", its stream input is received as a whole";
+				});
+
+			edge.output->disable_stream();
+			modules[edge.producer].next_indexes.push_back(edge.consumer);
+		}
+	}
+
+	/// \brief Indexes of all modules without incoming edges
+	std::vector< std::size_t > find_start_modules(
+		std::vector< chain_module_data > const& modules
+	){
+		std::vector< bool > has_precursor(modules.size(), false);
+		for(auto const& module: modules){
+			for(auto const next: module.next_indexes){
+				has_precursor[next] = true;
+			}
+		}
+
+		std::vector< std::size_t > result;
+		for(std::size_t i = 0; i < modules.size(); ++i){
+			if(!has_precursor[i]) result.push_back(i);
+		}
+		return result;
+	}
+
+
+	/// \brief Remove pure modules whose outputs no remaining module uses
+	///
+	/// The modules are visited in reverse topological order, so removing a
+	/// consumer can make its pure producers removable too. inputs contains
+	/// per module the outputs its inputs are connected to.
+	void remove_unused_pure_modules(
+		std::string_view const chain,
+		chain_module_list& list,
+		std::vector< std::vector< output_base* > > const& inputs
+	){
+		auto& modules = list.modules;
+		std::vector< bool > removed(modules.size(), false);
+		auto removed_any = false;
+		for(auto i = modules.size(); i-- > 0;){
+			auto const& data = modules[i];
+			if(!data.module->is_pure()) continue;
+
+			auto const outputs = data.module->output_name_to_ptr();
+			auto const used = std::any_of(outputs.begin(), outputs.end(),
+				[](auto const& output){
+					return output.second->use_count() > 0;
+				});
+
+			// successors by wait_on
+			auto const waited_on = std::any_of(
+				data.next_indexes.begin(), data.next_indexes.end(),
+				[&removed](std::size_t const next){ return !removed[next]; });
+
+			if(used || waited_on) continue;
+
+			logsys::log([chain, &data](logsys::stdlogb& os){
+					os << "chain(" << chain << ") module("
+						<< data.module->number << ":"
+						<< data.module->type_name
+						<< ") removed because it is pure and none of its "
+						"outputs is used";
+				});
+
+			removed[i] = true;
+			removed_any = true;
+			for(auto const output: inputs[i]){
+				output->remove_use();
+			}
+		}
+
+		if(!removed_any) return;
+
+		std::vector< std::size_t > new_index(modules.size());
+		std::size_t count = 0;
+		for(std::size_t i = 0; i < modules.size(); ++i){
+			if(!removed[i]) new_index[i] = count++;
+		}
+
+		auto const reindex = [&removed, &new_index](
+				std::vector< std::size_t >& indexes
+			){
+				std::vector< std::size_t > result;
+				for(auto const i: indexes){
+					if(!removed[i]) result.push_back(new_index[i]);
+				}
+				indexes = std::move(result);
+			};
+
+		std::vector< chain_module_data > result;
+		result.reserve(count);
+		for(std::size_t i = 0; i < modules.size(); ++i){
+			if(removed[i]) continue;
+			result.push_back(std::move(modules[i]));
+			reindex(result.back().next_indexes);
+			reindex(result.back().producer_indexes);
+		}
+
+		modules = std::move(result);
+		reindex(list.start_indexes);
+	}
+
+
+	/// \brief Remove all edges that are implied by a longer path
+	///
+	/// A -> C is removed if A -> B -> C exists. The reachability stays the
+	/// same, but every exec saves an atomic decrement and a scheduling
+	/// check per removed edge. The modules must be in topological order and
+	/// next_indexes must be sorted and free of duplicates.
+	void transitive_reduction(std::vector< chain_module_data >& modules){
+		auto const count = modules.size();
+
+		// reachable[i][j]: module j is reachable from module i by a path
+		// of length >= 1, built in reverse topological order
+		std::vector< std::vector< bool > > reachable(
+			count, std::vector< bool >(count, false));
+		for(std::size_t i = count; i-- > 0;){
+			for(auto const next: modules[i].next_indexes){
+				reachable[i][next] = true;
+				for(std::size_t j = next + 1; j < count; ++j){
+					if(reachable[next][j]) reachable[i][j] = true;
+				}
+			}
+		}
+
+		for(auto& module: modules){
+			auto& next_indexes = module.next_indexes;
+			auto const implied = [&](std::size_t const target){
+					return std::any_of(
+						next_indexes.begin(), next_indexes.end(),
+						[&](std::size_t const next){
+							return next != target && reachable[next][target];
+						});
+				};
+
+			std::vector< std::size_t > reduced;
+			for(auto const next: next_indexes){
+				if(!implied(next)) reduced.push_back(next);
+			}
+			next_indexes = std::move(reduced);
+		}
+	}
+
+	/// \brief Fill consumer_indexes from producer_indexes
+	void collect_consumers(std::vector< chain_module_data >& modules){
+		for(std::size_t i = 0; i < modules.size(); ++i){
+			for(auto const producer: modules[i].producer_indexes){
+				modules[producer].consumer_indexes.push_back(i);
+			}
+		}
+	}
+
+	/// \brief Set precursor_count to the count of incoming edges
+	void count_precursors(std::vector< chain_module_data >& modules){
+		for(auto& module: modules){
+			module.precursor_count = 0;
+		}
+
+		for(auto const& module: modules){
+			for(auto const next: module.next_indexes){
+				++modules[next].precursor_count;
+			}
+		}
+	}
+
+
 } }
 
 
@@ -116,12 +363,19 @@ namespace disposer{
 	chain_module_list create_chain_modules(
 		module_maker_list const& module_makers,
 		component_module_makers_list& component_module_makers,
-		types::embedded_config::chain const& config_chain
+		types::embedded_config::chain const& config_chain,
+		chain_parameters const& parameters
 	){
 		variables_map variables;
 
 		chain_module_list result;
 
+		// per module the outputs its inputs are connected to
+		std::vector< std::vector< output_base* > > connected_outputs;
+
+		// connections that might stream, decided after all are known
+		std::vector< stream_edge > stream_edges;
+
 		for(std::size_t i = 0; i < config_chain.modules.size(); ++i){
 			auto const& config_module = config_chain.modules[i];
 
@@ -129,44 +383,49 @@ namespace disposer{
 				os << "chain(" << config_chain.name << ") module("
 					<< i + 1 << ":" << config_module.type_name << ") created";
 			}, [&]{
-				std::size_t precursor_count = 0;
-
 				// add the number of this module to all its wait_on modules
 				for(auto wait_on: config_module.wait_ons){
 					result.modules[wait_on].next_indexes.push_back(i);
-					++precursor_count;
 				}
 
 				// create input list
 				input_list config_inputs;
-				if(
-					config_module.wait_ons.empty() &&
-					config_module.inputs.empty()
-				){
-					// add as starter module
-					result.start_indexes.push_back(i);
-				}else{
-					for(auto const& config_input: config_module.inputs){
-						// find variable
-						auto const iter = variables.find(config_input.variable);
-						assert(iter != variables.end());
-
-						// emplace input with connected output
-						auto const& output_data = iter->second;
-						auto const output_ptr = &(output_data.ptr);
-						config_inputs.emplace(config_input.name, output_ptr);
-
-						result.modules[output_data.output_module_number]
-							.next_indexes.push_back(i);
-						++precursor_count;
-
-						// remove config file variable if final use
-						if(config_input.transfer == in_transfer::move){
-							variables.erase(iter);
-						}
+				std::vector< std::size_t > producers;
+				auto& connected = connected_outputs.emplace_back();
+				for(auto const& config_input: config_module.inputs){
+					// find variable
+					auto const iter = variables.find(config_input.variable);
+					assert(iter != variables.end());
+
+					// emplace input with connected output
+					auto const& output_data = iter->second;
+					auto const output_ptr = &(output_data.ptr);
+					config_inputs.emplace(config_input.name, output_ptr);
+					connected.push_back(output_ptr);
+
+					// a stream is consumed while its producer is running,
+					// so the consumer doesn't wait on the producer
+					auto const output_module = output_data.output_module_number;
+					producers.push_back(output_module);
+					if(output_ptr->is_stream()){
+						stream_edges.push_back({output_module, i, output_ptr});
+					}else{
+						result.modules[output_module].next_indexes
+							.push_back(i);
+					}
+
+					// remove config file variable if final use
+					if(config_input.transfer == in_transfer::move){
+						variables.erase(iter);
 					}
 				}
 
+				// a module may read multiple outputs of the same producer
+				std::sort(producers.begin(), producers.end());
+				producers.erase(
+					std::unique(producers.begin(), producers.end()),
+					producers.end());
+
 				// create output list
 				output_list config_outputs;
 				for(auto const& config_output: config_module.outputs){
@@ -187,7 +446,7 @@ namespace disposer{
 							std::move(config_inputs),
 							std::move(config_outputs),
 							config_module.parameters
-						}), precursor_count, {}});
+						}), 0, {}, false, std::move(producers)});
 
 				// get a reference to the new module
 				auto& module = *result.modules.back().module;
@@ -195,10 +454,21 @@ namespace disposer{
 				// get outputs and add them to variables-output-map
 				auto const output_map = module.output_name_to_ptr();
 				for(auto const& config_output: config_module.outputs){
+					auto& output = *output_map.at(config_output.name);
+
+					// producer and consumer never run at the same time;
+					// an output with multiple inputs never streams, even
+					// if pure consumers are removed later
+					if(parameters.executor == chain_executor::caller_thread
+						|| !output.is_stream())
+					{
+						output.disable_stream();
+					}
+
 					variables.try_emplace(
 						config_output.variable,
 						module,
-						*output_map.at(config_output.name),
+						output,
 						i
 					);
 				}
@@ -207,16 +477,25 @@ namespace disposer{
 
 		assert(variables.empty());
 
+		decide_streams(config_chain.name, result.modules, stream_edges);
+		result.start_indexes = find_start_modules(result.modules);
+
 		// remove duplicates from next_indexes
-		for(auto& module: result.modules){
+		for(std::size_t i = 0; i < result.modules.size(); ++i){
+			auto& module = result.modules[i];
 			auto const first = module.next_indexes.begin();
 			auto const last = module.next_indexes.end();
 			std::sort(first, last);
-			auto const end = std::unique(first, last);
-			module.next_indexes.erase(end, last);
-			module.precursor_count -= last - end;
+			module.next_indexes.erase(std::unique(first, last), last);
+
+			// wait_on and inputs only refer to previous modules
+			assert(module.next_indexes.empty()
+				|| module.next_indexes.front() > i);
 		}
 
+		remove_unused_pure_modules(config_chain.name, result,
+			connected_outputs);
+
 		logsys::log([
 				chain = std::string_view(config_chain.name),
 				digraph = make_digraph(config_chain.name, result.modules)
@@ -224,6 +503,17 @@ namespace disposer{
 				os << "chain(" << chain << ") digraph: " << digraph;
 			});
 
+		transitive_reduction(result.modules);
+		count_precursors(result.modules);
+		collect_consumers(result.modules);
+
+		logsys::log([
+				chain = std::string_view(config_chain.name),
+				digraph = make_digraph(config_chain.name, result.modules)
+			](logsys::stdlogb& os){
+				os << "chain(" << chain << ") reduced digraph: " << digraph;
+			});
+
 		return result;
 	}
 
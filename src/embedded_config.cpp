@@ -111,9 +111,19 @@ namespace disposer{ namespace{
 			types::embedded_config::chain{
 				chain.name,
 				chain.id_generator.value_or("default"),
+				{},
 				{}
 			});
 
+		for(auto& parameter: chain.parameters){
+			if(!result_chain.parameters.emplace(
+				parameter.key, parameter.value).second
+			){
+				throw std::logic_error("in chain(" + result_chain.name
+					+ "): duplicate parameter '" + parameter.key + "'");
+			}
+		}
+
 		std::vector< std::string > module_types;
 		for(auto& module: chain.modules){
 			std::vector< std::size_t > wait_ons;
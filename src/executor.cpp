@@ -0,0 +1,424 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <disposer/core/executor.hpp>
+#include <disposer/tool/cpu_relax.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace disposer{
+
+
+	namespace{
+
+
+		/// \brief Index of the calling worker in its executor
+		thread_local std::size_t worker_index = executor::no_worker;
+
+
+		std::size_t default_worker_count(std::size_t const count)noexcept{
+			if(count > 0) return count;
+			auto const hardware = std::thread::hardware_concurrency();
+			return hardware > 0 ? hardware : 1;
+		}
+
+
+	}
+
+
+	executor::executor(std::size_t const worker_count)
+		: worker_count_(default_worker_count(worker_count))
+		, min_worker_count_(worker_count_.load())
+		, max_worker_count_(worker_count_.load())
+		, peak_worker_count_(worker_count_) {}
+
+	executor::~executor(){
+		std::unique_lock lock(mutex_);
+		shutdown_ = true;
+		lock.unlock();
+		cv_.notify_all();
+
+		// after shutdown_ is set, no other thread changes threads_
+		for(auto& thread: threads_){
+			if(thread.joinable()) thread.join();
+		}
+	}
+
+
+	void executor::post(task&& task){
+		post(std::move(task), default_class_);
+	}
+
+	void executor::post(
+		task&& task,
+		scheduling_class& cls,
+		time_point const deadline,
+		std::size_t const worker
+	){
+		// virtual time a task of weight 1 costs
+		constexpr std::uint64_t cost = std::uint64_t(1) << 20;
+
+		std::unique_lock lock(mutex_);
+
+		// a class that was idle doesn't get credit for the idle time
+		auto const start = std::max(cls.virtual_time_, virtual_time_);
+		auto const sequence = sequence_;
+		queued_task entry{std::move(task), cls.priority, deadline, start,
+			sequence};
+
+		// only an existing worker can take a task from its local queue
+		auto const local = worker < slots_.size() && slots_[worker].used;
+		auto const wake_all = local && slots_[worker].idle;
+		if(local){
+			slots_[worker].local.push_back(std::move(entry));
+			++local_count_;
+		}else{
+			tasks_.push_back(std::move(entry));
+			std::push_heap(tasks_.begin(), tasks_.end(),
+				&executor::runs_after);
+		}
+
+		auto const virtual_time = cls.virtual_time_;
+		cls.virtual_time_ = start + cost / cls.weight;
+		++sequence_;
+		pending_.store(queued(), std::memory_order_release);
+		try{
+			if(!started_){
+				started_ = true;
+				start_workers();
+			}else if(queued() > idle_ && worker_count_ < max_worker_count_){
+				// more work than idle workers, grow the pool
+				++worker_count_;
+				++grow_count_;
+				peak_worker_count_ = std::max(peak_worker_count_,
+					worker_count_.load());
+				start_workers();
+			}
+		}catch(...){
+			// a running worker takes the task, start_workers() tries again
+			// to reach worker_count_ at the next call
+			if(running_ == 0){
+				// without workers the task is taken back, so the caller
+				// knows it will never run
+				started_ = false;
+				cls.virtual_time_ = virtual_time;
+				if(local){
+					slots_[worker].local.pop_back();
+					--local_count_;
+				}else{
+					tasks_.erase(std::find_if(tasks_.begin(), tasks_.end(),
+						[sequence](queued_task const& entry){
+							return entry.sequence == sequence;
+						}));
+					std::make_heap(tasks_.begin(), tasks_.end(),
+						&executor::runs_after);
+				}
+				pending_.store(queued(), std::memory_order_release);
+				throw;
+			}
+		}
+
+		// spinning workers take the task without a wakeup, they lock mutex_
+		// before they sleep
+		auto const notify = queued() > spinning_;
+		lock.unlock();
+
+		// an idle preferred worker must wake up, notify_one might wake
+		// another worker that doesn't take the task
+		if(wake_all){
+			cv_.notify_all();
+		}else if(notify){
+			cv_.notify_one();
+		}
+	}
+
+
+	void executor::set_worker_count(std::size_t const count){
+		std::unique_lock lock(mutex_);
+		worker_count_ = default_worker_count(count);
+		min_worker_count_ = worker_count_.load();
+		max_worker_count_ = worker_count_.load();
+		peak_worker_count_ = std::max(peak_worker_count_,
+			worker_count_.load());
+		if(started_) start_workers();
+		lock.unlock();
+
+		// surplus workers end
+		cv_.notify_all();
+	}
+
+
+	void executor::set_elastic(
+		std::size_t const min,
+		std::size_t const max,
+		std::chrono::nanoseconds const idle_timeout
+	){
+		auto const lowest = std::max< std::size_t >(min, 1);
+		auto const highest = std::max(default_worker_count(max), lowest);
+
+		std::unique_lock lock(mutex_);
+		min_worker_count_ = lowest;
+		max_worker_count_ = highest;
+		idle_timeout_ = idle_timeout;
+		worker_count_ = std::clamp(worker_count_.load(), lowest, highest);
+		peak_worker_count_ = std::max(peak_worker_count_,
+			worker_count_.load());
+		if(started_) start_workers();
+		lock.unlock();
+
+		// surplus workers end, others use the new idle timeout
+		cv_.notify_all();
+	}
+
+
+	executor_metrics executor::metrics()const{
+		std::lock_guard lock(mutex_);
+		return {
+				worker_count_,
+				peak_worker_count_,
+				running_,
+				idle_,
+				queued(),
+				grow_count_,
+				shrink_count_
+			};
+	}
+
+
+	void executor::set_spinning(
+		std::size_t const count,
+		std::chrono::nanoseconds const duration
+	){
+		spin_duration_ = duration;
+		spinning_worker_count_ = count;
+	}
+
+
+	std::size_t executor::queue_size()const{
+		std::lock_guard lock(mutex_);
+		return queued();
+	}
+
+
+	bool executor::is_worker_thread()const noexcept{
+		return current_blocking_handler() == this;
+	}
+
+	std::size_t executor::current_worker()const noexcept{
+		return is_worker_thread() ? worker_index : no_worker;
+	}
+
+
+	void executor::begin_blocking()noexcept{
+		std::lock_guard lock(mutex_);
+		++blocked_;
+		try{
+			start_workers();
+		}catch(...){
+			// no compensation, the pool works with less threads
+		}
+	}
+
+	void executor::end_blocking()noexcept{
+		std::unique_lock lock(mutex_);
+		--blocked_;
+		auto const surplus = running_ - blocked_ > worker_count_;
+		lock.unlock();
+		if(surplus) cv_.notify_all();
+	}
+
+
+	void executor::start_workers(){
+		// the destructor joins all threads, threads_ must not change while
+		// it iterates
+		if(shutdown_) return;
+
+		// join threads that ended
+		for(auto const iter: exited_){
+			iter->join();
+			threads_.erase(iter);
+		}
+		exited_.clear();
+
+		while(running_ - blocked_ < worker_count_){
+			auto const iter = threads_.emplace(threads_.end());
+			try{
+				*iter = std::thread(&executor::run, this, iter);
+			}catch(...){
+				threads_.erase(iter);
+				throw;
+			}
+			++running_;
+		}
+	}
+
+
+	void executor::spin(std::chrono::nanoseconds const duration)const noexcept{
+		using clock = std::chrono::steady_clock;
+		auto const end = clock::now() + duration;
+		for(std::size_t i = 1;; ++i){
+			if(pending_.load(std::memory_order_acquire) > 0) return;
+			cpu_relax();
+
+			// reading the clock is much more expensive than the pause
+			if(i % 64 == 0 && clock::now() >= end) return;
+		}
+	}
+
+
+	bool executor::runs_after(
+		queued_task const& a,
+		queued_task const& b
+	)noexcept{
+		if(a.priority != b.priority) return a.priority < b.priority;
+		if(a.deadline != b.deadline) return a.deadline > b.deadline;
+		if(a.start != b.start) return a.start > b.start;
+		return a.sequence > b.sequence;
+	}
+
+
+	executor::task executor::pop_task(){
+		std::pop_heap(tasks_.begin(), tasks_.end(), &executor::runs_after);
+		auto& next = tasks_.back();
+		virtual_time_ = std::max(virtual_time_, next.start);
+		auto result = std::move(next.task);
+		tasks_.pop_back();
+		return result;
+	}
+
+
+	bool executor::has_task(std::size_t const self)const noexcept{
+		if(!tasks_.empty() || !slots_[self].local.empty()) return true;
+		if(local_count_ == 0) return false;
+		return std::any_of(slots_.begin(), slots_.end(),
+			[](worker_slot const& slot){
+				return slot.used && !slot.idle && !slot.local.empty();
+			});
+	}
+
+
+	executor::task executor::take_task(std::size_t const self){
+		auto const take_local = [this](worker_slot& slot){
+				auto result = std::move(slot.local.front().task);
+				slot.local.pop_front();
+				--local_count_;
+				return result;
+			};
+
+		auto& own = slots_[self];
+		if(!own.local.empty() && (tasks_.empty()
+			|| own.local.front().priority >= tasks_.front().priority))
+		{
+			return take_local(own);
+		}
+
+		if(!tasks_.empty()) return pop_task();
+
+		// the preferred worker is busy, run the task before it waits longer
+		for(auto& slot: slots_){
+			if(slot.used && !slot.idle && !slot.local.empty()){
+				return take_local(slot);
+			}
+		}
+
+		assert(false);
+		return {};
+	}
+
+
+	void executor::run(std::list< std::thread >::iterator const self)noexcept{
+		current_blocking_handler() = this;
+
+		std::unique_lock lock(mutex_);
+
+		// take the first free slot
+		auto const slot = std::find_if(slots_.begin(), slots_.end(),
+			[](worker_slot const& slot){ return !slot.used; })
+			- slots_.begin();
+		if(static_cast< std::size_t >(slot) == slots_.size()){
+			try{
+				slots_.emplace_back();
+			}catch(...){
+				--running_;
+				if(!shutdown_) exited_.push_back(self);
+				return;
+			}
+		}
+		worker_index = slot;
+		slots_[slot].used = true;
+
+		for(;;){
+			auto const surplus = [this]{
+					return running_ - blocked_ > worker_count_;
+				};
+
+			auto const ready = [this, &surplus, slot]{
+					return shutdown_ || has_task(slot) || surplus();
+				};
+
+			++idle_;
+			slots_[slot].idle = true;
+			if(!ready() && spinning_ < spinning_worker_count_){
+				++spinning_;
+				lock.unlock();
+				spin(spin_duration_);
+				lock.lock();
+				--spinning_;
+			}
+			while(!ready()){
+				if(!is_elastic()){
+					cv_.wait(lock, ready);
+				}else if(!cv_.wait_for(lock, idle_timeout_, ready)
+					&& worker_count_ > min_worker_count_)
+				{
+					// idle too long, shrink the pool by this worker
+					--worker_count_;
+					++shrink_count_;
+				}
+			}
+			slots_[slot].idle = false;
+			--idle_;
+
+			if(!has_task(slot) ? shutdown_ || surplus() : surplus()){
+				--running_;
+				if(!shutdown_) exited_.push_back(self);
+
+				// hand the local queue over to the other workers
+				auto& own = slots_[slot];
+				for(auto& entry: own.local){
+					tasks_.push_back(std::move(entry));
+					std::push_heap(tasks_.begin(), tasks_.end(),
+						&executor::runs_after);
+				}
+				local_count_ -= own.local.size();
+				own.local.clear();
+				own.used = false;
+
+				// the wakeup might have been for a task
+				if(!tasks_.empty()) cv_.notify_all();
+				return;
+			}
+
+			auto task = take_task(slot);
+			pending_.store(queued(), std::memory_order_relaxed);
+
+			// the remaining local tasks may now be taken by idle workers
+			auto const steal = !slots_[slot].local.empty() && idle_ > 0;
+			lock.unlock();
+			if(steal) cv_.notify_one();
+
+			task();
+
+			lock.lock();
+		}
+	}
+
+
+}
@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <disposer/tool/mapped_buffer.hpp>
+
+#include <system_error>
+#include <string>
+#include <cstdlib>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+namespace disposer{
+
+
+	namespace{
+
+
+		[[noreturn]] void throw_errno(char const* what){
+			throw std::system_error(errno, std::generic_category(),
+				std::string("mapped_buffer: ") + what);
+		}
+
+		/// \brief Closes the file descriptor at scope exit
+		struct file_guard{
+			int const fd;
+
+			~file_guard(){
+				::close(fd);
+			}
+		};
+
+
+	}
+
+
+	mapped_buffer::mapped_buffer(std::size_t const bytes)
+		: data_(nullptr)
+		, size_(bytes > 0 ? bytes : 1)
+	{
+		char const* const dir = std::getenv("TMPDIR");
+		std::string path = dir && *dir ? dir : "/tmp";
+		path += "/disposer_spill_XXXXXX";
+
+		int const fd = ::mkstemp(path.data());
+		if(fd < 0) throw_errno("mkstemp");
+		file_guard guard{fd};
+
+		// the mapping keeps the file alive
+		::unlink(path.c_str());
+
+		if(::ftruncate(fd, static_cast< off_t >(size_)) != 0){
+			throw_errno("ftruncate");
+		}
+
+		void* const data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0);
+		if(data == MAP_FAILED) throw_errno("mmap");
+		data_ = data;
+	}
+
+	mapped_buffer::~mapped_buffer(){
+		::munmap(data_, size_);
+	}
+
+
+}
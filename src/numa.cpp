@@ -0,0 +1,131 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <disposer/tool/numa.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace disposer{
+
+
+	namespace detail{
+
+
+		numa_node_set parse_numa_node_list(std::string const& list)noexcept{
+			try{
+				numa_node_set result{0, 0};
+				bool fits = true;
+
+				std::istringstream is(list);
+				std::string range;
+				while(std::getline(is, range, ',')){
+					auto const pos = range.find('-');
+					auto const first = std::stoul(range.substr(0, pos));
+					auto const last = pos == std::string::npos
+						? first : std::stoul(range.substr(pos + 1));
+					if(last < first) return {1, 1};
+
+					result.count += last - first + 1;
+					if(last < 64){
+						for(auto node = first; node <= last; ++node){
+							result.mask |= std::uint64_t(1) << node;
+						}
+					}else{
+						fits = false;
+					}
+				}
+
+				if(result.count == 0) return {1, 1};
+				if(!fits) result.mask = 0;
+				return result;
+			}catch(...){
+				return {1, 1};
+			}
+		}
+
+
+	}
+
+
+	namespace{
+
+
+		/// \brief Nodes with memory, determined once
+		detail::numa_node_set const& memory_nodes()noexcept{
+			static auto const nodes = []()noexcept{
+					std::ifstream is("/sys/devices/system/node/has_memory");
+					std::string list;
+					is >> list;
+					return detail::parse_numa_node_list(list);
+				}();
+			return nodes;
+		}
+
+
+	}
+
+
+	std::size_t numa_node_count()noexcept{
+		return memory_nodes().count;
+	}
+
+	std::size_t current_numa_node()noexcept{
+#ifdef __linux__
+		unsigned cpu = 0;
+		unsigned node = 0;
+		if(::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0){
+			return node;
+		}
+#endif
+		return 0;
+	}
+
+
+	numa_memory_policy::numa_memory_policy(std::size_t const node)noexcept
+		: active_(false)
+	{
+#ifdef __linux__
+		auto const& nodes = memory_nodes();
+		if(nodes.count < 2 || nodes.mask == 0) return;
+
+		// constants of <numaif.h>, we don't link libnuma
+		constexpr int mpol_preferred = 1;
+		constexpr int mpol_interleave = 3;
+
+		unsigned long mask = nodes.mask;
+		int mode = mpol_interleave;
+		if(node != numa_all_nodes){
+			if(node >= 64 || (nodes.mask & (std::uint64_t(1) << node)) == 0){
+				return;
+			}
+			mask = 1ul << node;
+			mode = mpol_preferred;
+		}
+
+		active_ = ::syscall(SYS_set_mempolicy, mode, &mask, 65ul) == 0;
+#else
+		(void)node; // silence unused warning
+#endif
+	}
+
+	numa_memory_policy::~numa_memory_policy(){
+#ifdef __linux__
+		// MPOL_DEFAULT
+		if(active_) ::syscall(SYS_set_mempolicy, 0, nullptr, 0ul);
+#endif
+	}
+
+
+}
@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <disposer/core/parallel.hpp>
+#include <disposer/core/executor.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+
+namespace disposer{
+
+
+	namespace{
+
+
+		/// \brief Shared by the caller and the helper tasks
+		///
+		/// Helpers that start after all chunks are claimed don't touch fn,
+		/// so the caller can return before they ran.
+		class parallel_state{
+		public:
+			parallel_state(
+				std::size_t const count,
+				std::size_t const chunk_count,
+				std::function< void(std::size_t, std::size_t) > const& fn
+			)noexcept
+				: count_(count)
+				, chunk_count_(chunk_count)
+				, fn_(fn) {}
+
+			/// \brief Process chunks until all are claimed
+			void work()noexcept{
+				for(;;){
+					auto const chunk = next_++;
+					if(chunk >= chunk_count_) return;
+
+					if(!failed_){
+						try{
+							fn_(count_ * chunk / chunk_count_,
+								count_ * (chunk + 1) / chunk_count_);
+						}catch(...){
+							std::lock_guard lock(mutex_);
+							if(!error_) error_ = std::current_exception();
+							failed_ = true;
+						}
+					}
+
+					if(++done_ == chunk_count_){
+						// lock to avoid a lost wakeup in wait()
+						{ std::lock_guard lock(mutex_); }
+						cv_.notify_all();
+					}
+				}
+			}
+
+			/// \brief Block until all chunks are done, rethrow the first
+			///        exception
+			void wait(){
+				std::unique_lock lock(mutex_);
+				auto const ready = [this]{ return done_ == chunk_count_; };
+				if(!ready()){
+					managed_blocking blocking;
+					cv_.wait(lock, ready);
+				}
+
+				if(error_) std::rethrow_exception(error_);
+			}
+
+		private:
+			std::size_t const count_;
+			std::size_t const chunk_count_;
+			std::function< void(std::size_t, std::size_t) > const& fn_;
+
+			std::atomic< std::size_t > next_{0};
+			std::atomic< std::size_t > done_{0};
+			std::atomic< bool > failed_{false};
+
+			std::mutex mutex_;
+			std::condition_variable cv_;
+			std::exception_ptr error_;
+		};
+
+
+	}
+
+
+	void parallel_chunks(
+		executor* const executor,
+		scheduling_class* const scheduling,
+		std::size_t const count,
+		std::function< void(std::size_t, std::size_t) > const& fn
+	){
+		if(count == 0) return;
+
+		// some chunks per thread compensate for unequal costs
+		auto const workers = executor ? executor->worker_count() : 0;
+		auto const chunk_count = std::min(count, 4 * (workers + 1));
+		if(chunk_count == 1){
+			fn(0, count);
+			return;
+		}
+
+		auto const state =
+			std::make_shared< parallel_state >(count, chunk_count, fn);
+
+		auto const helpers = std::min(chunk_count - 1, workers);
+		for(std::size_t i = 0; i < helpers; ++i){
+			try{
+				auto task = [state]{ state->work(); };
+				if(scheduling){
+					executor->post(std::move(task), *scheduling);
+				}else{
+					executor->post(std::move(task));
+				}
+			}catch(...){
+				// the calling thread does the remaining work
+				break;
+			}
+		}
+
+		state->work();
+		state->wait();
+	}
+
+
+}
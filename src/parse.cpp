@@ -68,10 +68,17 @@ BOOST_FUSION_ADAPT_STRUCT(
 	outputs
 )
 
+BOOST_FUSION_ADAPT_STRUCT(
+	disposer::types::parse::chain_parameter,
+	key,
+	value
+)
+
 BOOST_FUSION_ADAPT_STRUCT(
 	disposer::types::parse::chain,
 	name,
 	id_generator,
+	parameters,
 	modules
 )
 
@@ -452,6 +459,14 @@ namespace disposer::parser{
 	x3::rule< chain_params_tag, std::vector< type::module > >
 		const chain_params("chain_params");
 
+	struct chain_param_tag;
+	x3::rule< chain_param_tag, type::chain_parameter >
+		const chain_param("chain_param");
+
+	struct chain_param_list_tag;
+	x3::rule< chain_param_list_tag, std::vector< type::chain_parameter > >
+		const chain_param_list("chain_param_list");
+
 	struct id_generator_tag;
 	x3::rule< id_generator_tag, std::string > const
 		id_generator("id_generator");
@@ -584,8 +599,17 @@ namespace disposer::parser{
 		x3::expect[+module]
 	;
 
+	auto const chain_param_def =
+		"\t\t\t" > keyword > *space > '=' > *space > value > separator
+	;
+
+	auto const chain_param_list_def =
+		("\t\tparameter" >> separator) > +chain_param
+	;
+
 	auto const chain_def =
 		('\t' > (keyword >> *space) > -id_generator > separator) >>
+		-chain_param_list >>
 		chain_params
 	;
 
@@ -766,6 +790,18 @@ namespace disposer::parser{
 		}
 	};
 
+	struct chain_param_tag: error_base< chain_param_tag >{
+		const char* message()const{
+			return "a chain parameter '\t\t\tname = value\n'";
+		}
+	};
+
+	struct chain_param_list_tag: error_base< chain_param_list_tag >{
+		const char* message()const{
+			return "at least one chain parameter '\t\t\tname = value\n'";
+		}
+	};
+
 	struct chains_params_tag: error_base< chains_params_tag >{
 		const char* message()const{
 			return "at least one chain line '\tname [= id_generator]\n'";
@@ -908,6 +944,8 @@ namespace disposer::parser{
 	BOOST_SPIRIT_DEFINE(output_params)
 	BOOST_SPIRIT_DEFINE(module)
 	BOOST_SPIRIT_DEFINE(chain_params)
+	BOOST_SPIRIT_DEFINE(chain_param)
+	BOOST_SPIRIT_DEFINE(chain_param_list)
 	BOOST_SPIRIT_DEFINE(chain)
 	BOOST_SPIRIT_DEFINE(chain_config)
 	BOOST_SPIRIT_DEFINE(id_generator)
@@ -24,6 +24,13 @@
 namespace disposer{ namespace{
 
 
+	/// \brief Count of log id's a thread reserves at once
+	///
+	/// The id_generators are shared by many chains, a block per thread
+	/// avoids contention on the counter.
+	constexpr std::size_t id_block_size = 64;
+
+
 	component_ptr create_component(
 		component_maker_list const& module_makers,
 		component_make_data const& data,
@@ -48,7 +55,9 @@ namespace disposer{ namespace{
 	auto create_chains(
 		module_maker_list const& module_makers,
 		component_module_makers_list& component_module_makers,
-		types::embedded_config::chains_config const& config
+		types::embedded_config::chains_config const& config,
+		memory_usage& memory,
+		executor& executor
 	){
 		std::unordered_set< std::string > inactive_chains;
 		std::unordered_map< std::string, chain > chains;
@@ -92,7 +101,11 @@ namespace disposer{ namespace{
 							module_makers,
 							component_module_makers,
 							config_chain,
-							id_generators[config_chain.id_generator]
+							id_generators.try_emplace(
+								config_chain.id_generator, id_block_size
+							).first->second,
+							memory,
+							executor
 						);
 				});
 		}
@@ -112,6 +125,8 @@ namespace disposer{
 
 
 	system::~system(){
+		triggers_.shutdown();
+
 		for(auto& [name, component]: components_){
 			logsys::exception_catching_log(
 				[&name = name](logsys::stdlogb& os){
@@ -200,7 +215,9 @@ namespace disposer{
 					disposer::create_chains(
 						directory_.module_maker_list_,
 						directory_.component_module_maker_list_,
-						embedded_config.chains);
+						embedded_config.chains,
+						memory_,
+						executor_);
 				config_ = std::move(config);
 			});
 
@@ -316,7 +333,11 @@ namespace disposer{
 						directory_.module_maker_list_,
 						directory_.component_module_maker_list_,
 						embedded_config,
-						id_generators_[embedded_config.id_generator]
+						id_generators_.try_emplace(
+							embedded_config.id_generator, id_block_size
+						).first->second,
+						memory_,
+						executor_
 					);
 
 				config_.chains.push_back(std::move(config));
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2018 Benjamin Buch
+//
+// https://github.com/bebuch/disposer
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+//-----------------------------------------------------------------------------
+#include <disposer/core/trigger_queue.hpp>
+#include <disposer/core/system.hpp>
+
+#include <logsys/log.hpp>
+#include <logsys/stdlogb.hpp>
+
+#include <system_error>
+#include <memory>
+#include <cerrno>
+
+
+namespace disposer{
+
+
+	trigger_queue::trigger_queue(
+		class system& system,
+		disposer::executor& executor,
+		std::size_t const capacity
+	)
+		: system_(system)
+		, executor_(executor)
+		, queue_(capacity)
+	{
+		if(::sem_init(&wake_, 0, 0) != 0){
+			throw std::system_error(errno, std::generic_category(),
+				"trigger_queue: sem_init");
+		}
+
+		try{
+			dispatcher_ = std::thread(&trigger_queue::dispatch, this);
+		}catch(...){
+			::sem_destroy(&wake_);
+			throw;
+		}
+	}
+
+	trigger_queue::~trigger_queue(){
+		shutdown();
+		::sem_destroy(&wake_);
+	}
+
+
+	bool trigger_queue::trigger(std::string chain, callback on_done){
+		// count first, so shutdown() can't miss an accepted request
+		++active_;
+		if(closed_ || !queue_.try_emplace(
+			request{std::move(chain), std::move(on_done)}))
+		{
+			finish();
+			return false;
+		}
+
+		wake();
+		return true;
+	}
+
+
+	void trigger_queue::shutdown(){
+		closed_ = true;
+
+		{
+			std::unique_lock lock(mutex_);
+			cv_.wait(lock, [this]{ return active_ == 0; });
+		}
+
+		// every later trigger() is rejected, so the dispatcher is done
+		stop_ = true;
+		::sem_post(&wake_);
+		if(dispatcher_.joinable()) dispatcher_.join();
+	}
+
+
+	void trigger_queue::wake()noexcept{
+		// pairs with the fence in dispatch(), so either the dispatcher sees
+		// the new request or this sees it sleeping
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(sleeping_.exchange(false)) ::sem_post(&wake_);
+	}
+
+
+	void trigger_queue::dispatch()noexcept{
+		while(!stop_){
+			while(auto queued = queue_.try_pop()){
+				// the request is shared with the task, so it can still be
+				// answered here if post() fails
+				std::shared_ptr< request > posted;
+				try{
+					posted = std::make_shared< request >(std::move(*queued));
+					executor_.post([this, posted]{ exec(*posted); });
+				}catch(...){
+					// post() doesn't queue the task if it throws
+					exec(posted ? *posted : *queued);
+				}
+			}
+
+			sleeping_ = true;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(queue_.empty() && !stop_){
+				// a surplus post of wake() only causes an extra loop
+				while(::sem_wait(&wake_) != 0 && errno == EINTR);
+			}
+			sleeping_ = false;
+		}
+	}
+
+
+	void trigger_queue::exec(request& request)noexcept{
+		auto info = logsys::exception_catching_log(
+			[&request](logsys::stdlogb& os){
+				os << "chain(" << request.chain << ") triggered exec";
+			}, [this, &request]{
+				return system_.get_chain(request.chain).exec();
+			});
+
+		if(request.on_done){
+			logsys::exception_catching_log(
+				[&request](logsys::stdlogb& os){
+					os << "chain(" << request.chain << ") trigger callback";
+				}, [&request, &info]{ request.on_done(std::move(info)); });
+		}
+
+		finish();
+	}
+
+
+	void trigger_queue::finish()noexcept{
+		if(--active_ == 0 && closed_){
+			// notify under the lock, shutdown() and the destructor can't
+			// finish before
+			std::lock_guard lock(mutex_);
+			cv_.notify_all();
+		}
+	}
+
+
+}
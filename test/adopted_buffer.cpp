@@ -0,0 +1,66 @@
+#include <disposer/core/input.hpp>
+#include <disposer/core/exec_input.hpp>
+
+#define BOOST_TEST_MODULE disposer adopted_buffer
+#include <boost/test/included/unit_test.hpp>
+
+#include <array>
+
+
+using namespace disposer;
+using namespace disposer::literals;
+
+
+BOOST_AUTO_TEST_CASE(release_with_last_copy){
+	std::array< int, 4 > memory{{1, 2, 3, 4}};
+	int released = 0;
+
+	{
+		adopted_buffer< int > buffer(memory.data(), memory.size(),
+			[&released]{ ++released; });
+		auto copy = buffer;
+		BOOST_TEST(copy.use_count() == 2);
+		BOOST_TEST(copy.as_span().data() == memory.data());
+		BOOST_TEST(copy[3] == 4);
+	}
+
+	BOOST_TEST(released == 1);
+}
+
+BOOST_AUTO_TEST_CASE(release_on_last_cleanup){
+	using buffer = adopted_buffer< unsigned char >;
+
+	std::array< unsigned char, 16 > frame{};
+	int released = 0;
+
+	output< decltype("o"_out), buffer > o{2};
+	input< decltype("a"_in), buffer, true > a{&o};
+	input< decltype("b"_in), buffer, true > b{&o};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), buffer > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	exec_input< decltype("a"_in), buffer, true > ea(
+		hana::tuple< input< decltype("a"_in), buffer, true > const&,
+			output_map_type const& >{a, map});
+	exec_input< decltype("b"_in), buffer, true > eb(
+		hana::tuple< input< decltype("b"_in), buffer, true > const&,
+			output_map_type const& >{b, map});
+
+	eo.push_external(frame.data(), frame.size(), [&released]{ ++released; });
+	eo.close(true);
+
+	{
+		auto const data = ea.references();
+		BOOST_TEST(data[0].data() == frame.data());
+	}
+	ea.cleanup();
+	BOOST_TEST(released == 0);
+
+	{
+		auto const data = eb.references();
+		BOOST_TEST(data[0].size() == frame.size());
+	}
+	eb.cleanup();
+	BOOST_TEST(released == 1);
+}
@@ -0,0 +1,1426 @@
+#include <disposer/core/system.hpp>
+#include <disposer/module.hpp>
+
+#define BOOST_TEST_MODULE disposer chain_exec
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <mutex>
+
+
+using namespace disposer;
+using namespace disposer::literals;
+
+
+namespace{
+
+
+	std::mutex mutex;
+	std::vector< int > results;
+	std::vector< std::thread::id > threads;
+
+	// if set, the next counter exec sleeps after setting counter_started
+	std::atomic< bool > slow_counter{false};
+	std::atomic< bool > counter_started{false};
+
+	// counts its copies, exec arguments must be moved
+	struct frame{
+		frame(int value): value(value) {}
+		frame(frame const& other): value(other.value) { ++copies; }
+		frame(frame&&) = default;
+		frame& operator=(frame const&) = default;
+		frame& operator=(frame&&) = default;
+
+		int value;
+		static std::atomic< int > copies;
+	};
+
+	std::atomic< int > frame::copies{0};
+
+	// count of state objects the scratch modules created
+	std::atomic< int > scratch_states{0};
+
+	// count of execs inside the memoized barrier module
+	std::atomic< int > barrier_count{0};
+
+
+	void record(int value){
+		std::lock_guard lock(mutex);
+		results.push_back(value);
+		threads.push_back(std::this_thread::get_id());
+	}
+
+	void reset(){
+		results.clear();
+		threads.clear();
+	}
+
+
+	void declare_modules(declarant& declarant){
+		generate_module(
+			"source module",
+			module_configure(
+				make("value"_param, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "the value")
+			),
+			exec_fn([](auto module){
+				record(module("value"_param));
+				module("value"_out).push(module("value"_param));
+			})
+		)("source", declarant);
+
+		generate_module(
+			"increment module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "value + 1")
+			),
+			exec_fn([](auto module){
+				for(auto const& v: module("value"_in).references()){
+					record(v + 1);
+					module("value"_out).push(v + 1);
+				}
+			})
+		)("increment", declarant);
+
+		generate_module(
+			"pure increment module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "value + 1")
+			),
+			exec_fn(pure([](auto module){
+				for(auto const& v: module("value"_in).references()){
+					record(100 + v);
+					module("value"_out).push(v + 1);
+				}
+			}))
+		)("pure_increment", declarant);
+
+		generate_module(
+			"memoized increment module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "value + 1")
+			),
+			exec_fn(pure([](auto module){
+				for(auto const& v: module("value"_in).references()){
+					record(100 + v);
+					module("value"_out).push(v + 1);
+				}
+			}, memoize(2)))
+		)("memoized_increment", declarant);
+
+		// pushes via an appender
+		generate_module(
+			"memoized appender increment module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "value + 1")
+			),
+			exec_fn(pure([](auto module){
+				auto appender = module("value"_out).appender();
+				for(auto const& v: module("value"_in).references()){
+					record(100 + v);
+					appender.push(v + 1);
+				}
+			}, memoize(2)))
+		)("memoized_appender_increment", declarant);
+
+		// adds the optional offset if connected
+		generate_module(
+			"memoized offset increment module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("offset"_in, free_type_c< int >, "an offset",
+					not_required),
+				make("value"_out, free_type_c< int >, "value + offset + 1")
+			),
+			exec_fn(pure([](auto module){
+				int offset = 0;
+				if(module("offset"_in).is_connected()){
+					for(auto const& v: module("offset"_in).references()){
+						offset += v;
+					}
+				}
+				for(auto const& v: module("value"_in).references()){
+					record(100 + v);
+					module("value"_out).push(v + offset + 1);
+				}
+			}, memoize(2)))
+		)("memoized_offset_increment", declarant);
+
+		// sums all elements of its input
+		generate_module(
+			"memoized sum module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "values"),
+				make("value"_out, free_type_c< int >, "sum of the values")
+			),
+			exec_fn(pure([](auto module){
+				int sum = 0;
+				for(auto const& v: module("value"_in).references()) sum += v;
+				record(sum);
+				module("value"_out).push(sum);
+			}, memoize(2)))
+		)("memoized_sum", declarant);
+
+		// waits until a second exec runs, so both miss the cache
+		generate_module(
+			"memoized barrier increment module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "value + 1")
+			),
+			exec_fn(pure([](auto module){
+				++barrier_count;
+				auto const end = std::chrono::steady_clock::now()
+					+ std::chrono::seconds(5);
+				while(barrier_count < 2
+					&& std::chrono::steady_clock::now() < end
+				){
+					std::this_thread::yield();
+				}
+
+				for(auto const& v: module("value"_in).references()){
+					record(100 + v);
+					module("value"_out).push(v + 1);
+				}
+			}, memoize(2)))
+		)("memoized_barrier_increment", declarant);
+
+		generate_module(
+			"sink module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value")
+			),
+			exec_fn([](auto module){
+				for(auto const& v: module("value"_in).references()){
+					record(-v);
+				}
+			})
+		)("sink", declarant);
+
+		generate_module(
+			"external module",
+			module_configure(
+				make("value"_out, free_type_c< frame >,
+					"the exec argument 'value'")
+			),
+			exec_fn(external_input("value", "value"_out))
+		)("external", declarant);
+
+		generate_module(
+			"frame sink module",
+			module_configure(
+				make("value"_in, free_type_c< frame >, "a value")
+			),
+			exec_fn([](auto module){
+				for(auto const& v: module("value"_in).references()){
+					record(v.value);
+				}
+			})
+		)("frame_sink", declarant);
+
+		generate_module(
+			"frame to int module",
+			module_configure(
+				make("value"_in, free_type_c< frame >, "a frame"),
+				make("value"_out, free_type_c< int >, "its value")
+			),
+			exec_fn([](auto module){
+				for(auto const& v: module("value"_in).references()){
+					module("value"_out).push(v.value);
+				}
+			})
+		)("frame_to_int", declarant);
+
+		generate_module(
+			"result module",
+			module_configure(
+				make("value"_in, free_type_c< frame >, "a value")
+			),
+			exec_fn(external_output("value", "value"_in))
+		)("result", declarant);
+
+		generate_module(
+			"failing module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "never set")
+			),
+			exec_fn([](auto){
+				throw std::runtime_error("failing module");
+			})
+		)("failing", declarant);
+
+		generate_module(
+			"sum module",
+			module_configure(
+				make("first"_in, free_type_c< int >, "a value"),
+				make("second"_in, free_type_c< int >, "a value")
+			),
+			exec_fn([](auto module){
+				auto const x = module("first"_in).references();
+				auto const y = module("second"_in).references();
+				record(1000 + x[0] + y[0]);
+			})
+		)("sum", declarant);
+
+		// every module object counts its own execs, the order of the exec
+		// ids is checked by no_overtaking
+		generate_module(
+			"counter module",
+			module_init_fn([](auto const&){ return std::size_t(0); }),
+			exec_fn([](auto module){
+				if(slow_counter.exchange(false)){
+					counter_started = true;
+					std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				}
+				record(static_cast< int >(module.state()++));
+			}),
+			no_overtaking
+		)("counter", declarant);
+
+		// the state is not thread safe, every running exec needs its own
+		struct scratch_state{
+			bool busy = false;
+		};
+
+		generate_module(
+			"scratch module",
+			module_init_fn(per_worker_state([](auto const&){
+				++scratch_states;
+				return scratch_state{};
+			})),
+			exec_fn([](auto module){
+				auto& state = module.state();
+				record(state.busy ? 1 : 0);
+				state.busy = true;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				state.busy = false;
+			})
+		)("scratch", declarant);
+
+		generate_module(
+			"parallel module",
+			exec_fn([](auto module){
+				std::vector< int > values(1000);
+				module.parallel_for(values.size(), [&values](std::size_t i){
+						values[i] = static_cast< int >(i);
+					});
+
+				std::vector< int > doubled(values.size());
+				module.parallel_transform(values, doubled.begin(),
+					[](int v){ return 2 * v; });
+
+				std::atomic< int > odd{0};
+				module.parallel_for(doubled, [&odd](int v){
+						if(v % 2 != 0) ++odd;
+					});
+
+				record(odd);
+				record(module.parallel_reduce(doubled, 0,
+					[](int a, int b){ return a + b; }));
+			})
+		)("parallel", declarant);
+
+		generate_module(
+			"range module",
+			module_configure(
+				make("count"_param, free_type_c< int >, "element count"),
+				make("value"_out, free_type_c< int >, "0 to count - 1")
+			),
+			exec_fn([](auto module){
+				for(int i = 0; i < module("count"_param); ++i){
+					module("value"_out).push(i);
+				}
+			})
+		)("range", declarant);
+
+		// pushes more elements than the stream can buffer
+		generate_module(
+			"stream range module",
+			module_configure(
+				make("count"_param, free_type_c< int >, "element count"),
+				make("value"_out, free_type_c< int >, "0 to count - 1",
+					output_stream{2}),
+				make("count"_out, free_type_c< int >, "count")
+			),
+			exec_fn([](auto module){
+				module("count"_out).push(module("count"_param));
+				for(int i = 0; i < module("count"_param); ++i){
+					module("value"_out).push(i);
+				}
+			})
+		)("stream_range", declarant);
+
+		// reads the second input before the stream
+		generate_module(
+			"stream sum module",
+			module_configure(
+				make("first"_in, free_type_c< int >, "a stream"),
+				make("second"_in, free_type_c< int >, "a value")
+			),
+			exec_fn([](auto module){
+				auto const y = module("second"_in).references();
+				int sum = 0;
+				for(auto&& v: module("first"_in).stream()) sum += v;
+				record(sum);
+				record(y[0]);
+			})
+		)("stream_sum", declarant);
+
+		generate_module(
+			"square module",
+			module_configure(
+				make("value"_in, free_type_c< int >, "a value"),
+				make("value"_out, free_type_c< int >, "value * value")
+			),
+			exec_fn(element_wise("value"_in, "value"_out,
+				[](int v){ return v * v; }))
+		)("square", declarant);
+	}
+
+
+}
+
+
+BOOST_AUTO_TEST_CASE(inline_executor){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = inline
+		source
+			parameter
+				value = 1
+			->
+				value = >a
+		increment
+			<-
+				value = <a
+			->
+				value = >b
+		sink
+			<-
+				value = <b
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	BOOST_TEST((chain.parameters().executor == chain_executor::caller_thread));
+
+	reset();
+	chain.enable();
+	auto const info = chain.exec();
+	chain.disable();
+
+	BOOST_TEST(info.success);
+	BOOST_TEST((results == std::vector< int >{1, 2, -2}));
+	for(auto const& id: threads){
+		BOOST_TEST((id == std::this_thread::get_id()));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_executor){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		source
+			parameter
+				value = 5
+			->
+				value = >a
+		increment
+			<-
+				value = <a
+			->
+				value = >b
+		sink
+			<-
+				value = <b
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	BOOST_TEST((chain.parameters().executor == chain_executor::parallel));
+
+	reset();
+	chain.enable();
+	auto const info = chain.exec();
+	chain.disable();
+
+	BOOST_TEST(info.success);
+	BOOST_TEST((results == std::vector< int >{5, 6, -6}));
+}
+
+BOOST_AUTO_TEST_CASE(unknown_chain_parameter){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			speed = fast
+		source
+			parameter
+				value = 1
+)file");
+	BOOST_CHECK_THROW(system.load_config(config), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(scheduling_requires_adaptive_executor){
+	for(auto const executor: {"", "parallel", "inline", "adaptive"}){
+		for(auto const key: {"priority = 1", "weight = 2", "deadline = 20"}){
+			disposer::system system;
+			declare_modules(system.directory().declarant());
+
+			auto const line = *executor
+				? std::string("\n\t\t\texecutor = ") + executor
+				: std::string();
+			std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			)file") + key + line + R"file(
+		source
+			parameter
+				value = 1
+)file");
+			if(std::string_view(executor) == "adaptive"){
+				BOOST_CHECK_NO_THROW(system.load_config(config));
+			}else{
+				BOOST_CHECK_THROW(system.load_config(config),
+					std::logic_error);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(adaptive_executor){
+	disposer::system system;
+	system.executor().set_worker_count(2);
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = adaptive
+		source
+			parameter
+				value = 10
+			->
+				value = >a
+		increment
+			<-
+				value = &a
+			->
+				value = >b
+		increment
+			<-
+				value = <a
+			->
+				value = >c
+		sink
+			<-
+				value = <b
+		sink
+			wait_on = 4:sink
+			<-
+				value = <c
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	BOOST_TEST((chain.parameters().executor == chain_executor::adaptive));
+
+	chain.enable();
+	for(std::size_t i = 0; i < 20; ++i){
+		reset();
+		auto const info = chain.exec();
+		BOOST_TEST(info.success);
+
+		std::lock_guard lock(mutex);
+		BOOST_TEST(results.size() == 5);
+		BOOST_TEST(results.front() == 10);
+		BOOST_TEST(results.back() == -11);
+		BOOST_TEST(std::count(results.begin(), results.end(), 11) == 2);
+	}
+	chain.disable();
+}
+
+BOOST_AUTO_TEST_CASE(redundant_and_duplicate_edges){
+	for(auto const executor: {"parallel", "inline", "adaptive"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		// sum 3 waits on source via increment and directly, sum 4 has both
+		// inputs from the same output
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+		source
+			parameter
+				value = 1
+			->
+				value = >a
+		increment
+			<-
+				value = &a
+			->
+				value = >b
+		sum
+			wait_on = 1:source
+			<-
+				first = &a
+				second = <b
+		sum
+			<-
+				first = &a
+				second = <a
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		reset();
+		chain.enable();
+		auto const info = chain.exec();
+		chain.disable();
+
+		BOOST_TEST(info.success);
+		std::lock_guard lock(mutex);
+		BOOST_TEST(results.size() == 4);
+		BOOST_TEST(std::count(results.begin(), results.end(), 1003) == 1);
+		BOOST_TEST(std::count(results.begin(), results.end(), 1002) == 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(triggered_exec){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = inline
+		source
+			parameter
+				value = 1
+			->
+				value = >a
+		sink
+			<-
+				value = <a
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	reset();
+	chain.enable();
+
+	std::atomic< std::size_t > succeeded{0};
+	std::atomic< std::size_t > failed{0};
+	auto const on_done = [&](std::optional< exec_info > info){
+			if(info && info->success){ ++succeeded; }else{ ++failed; }
+		};
+
+	std::vector< std::thread > producers;
+	for(std::size_t i = 0; i < 4; ++i){
+		producers.emplace_back([&]{
+				for(std::size_t j = 0; j < 25; ++j){
+					while(!system.triggers().trigger("c", on_done)){
+						std::this_thread::yield();
+					}
+				}
+			});
+	}
+	for(auto& producer: producers) producer.join();
+
+	BOOST_TEST(system.triggers().trigger("unknown", on_done));
+
+	while(succeeded + failed < 101) std::this_thread::yield();
+	BOOST_TEST(succeeded == 100);
+	BOOST_TEST(failed == 1);
+	BOOST_TEST(system.triggers().pending() == 0);
+
+	chain.disable();
+
+	std::lock_guard lock(mutex);
+	BOOST_TEST(results.size() == 200);
+}
+
+BOOST_AUTO_TEST_CASE(replicas){
+	for(auto const distribution: {"round_robin", "least_loaded"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			replicas = 3
+			distribution = )file") + distribution + R"file(
+			in_order = true
+		counter
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		BOOST_TEST(chain.replica_count() == 3);
+		BOOST_TEST(chain.parameters().in_order);
+
+		reset();
+		chain.enable();
+
+		// the first exec is slow, the second runs on another replica but
+		// must not return before the first
+		slow_counter = true;
+		counter_started = false;
+		std::thread slow([&chain]{ BOOST_TEST(chain.exec().success); });
+		while(!counter_started) std::this_thread::yield();
+		auto const start = std::chrono::steady_clock::now();
+		BOOST_TEST(chain.exec().success);
+		BOOST_TEST((std::chrono::steady_clock::now() - start
+			> std::chrono::milliseconds(50)));
+		slow.join();
+
+		std::vector< std::thread > callers;
+		for(std::size_t i = 0; i < 4; ++i){
+			callers.emplace_back([&chain]{
+					for(std::size_t j = 0; j < 30; ++j){
+						BOOST_TEST(chain.exec().success);
+					}
+				});
+		}
+		for(auto& caller: callers) caller.join();
+
+		chain.disable();
+
+		// every exec ran on one of 3 independent counters
+		std::lock_guard lock(mutex);
+		BOOST_TEST(results.size() == 122);
+		std::sort(results.begin(), results.end());
+		if(std::string(distribution) == "round_robin"){
+			for(std::size_t i = 0; i < 120; ++i){
+				BOOST_TEST(results[i] == static_cast< int >(i / 3));
+			}
+		}else{
+			BOOST_TEST(std::count(results.begin(), results.end(), 0) <= 3);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(per_worker_state_objects){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		scratch
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	reset();
+	scratch_states = 0;
+	chain.enable();
+
+	// further state objects are created when execs overlap
+	BOOST_TEST(scratch_states == 1);
+
+	std::vector< std::thread > callers;
+	for(std::size_t i = 0; i < 8; ++i){
+		callers.emplace_back([&chain]{
+				for(std::size_t j = 0; j < 20; ++j){
+					BOOST_TEST(chain.exec().success);
+				}
+			});
+	}
+	for(auto& caller: callers) caller.join();
+
+	chain.disable();
+	BOOST_TEST(scratch_states <= 8);
+
+	// no exec saw a state object that was in use by another exec
+	std::lock_guard lock(mutex);
+	BOOST_TEST(results.size() == 160);
+	BOOST_TEST(std::count(results.begin(), results.end(), 1) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(nested_parallelism){
+	for(auto const executor: {"parallel", "inline", "adaptive"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+		parallel
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		reset();
+		chain.enable();
+		BOOST_TEST(chain.exec().success);
+		chain.disable();
+
+		std::lock_guard lock(mutex);
+		BOOST_TEST((results == std::vector< int >{0, 999000}));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(element_wise_module){
+	for(auto const executor: {"parallel", "adaptive"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+		range
+			parameter
+				count = 1000
+			->
+				value = >a
+		square
+			<-
+				value = <a
+			->
+				value = >b
+		sink
+			<-
+				value = <b
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		reset();
+		chain.enable();
+		BOOST_TEST(chain.exec().success);
+		chain.disable();
+
+		// sink records the negative values in input order
+		std::lock_guard lock(mutex);
+		BOOST_TEST_REQUIRE(results.size() == 1000);
+		for(std::size_t i = 0; i < results.size(); ++i){
+			BOOST_TEST(results[i] == -static_cast< int >(i * i));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(per_module_details){
+	for(auto const executor: {"inline", "parallel", "adaptive"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+			details = true
+		source
+			parameter
+				value = 1
+			->
+				value = >a
+		failing
+			<-
+				value = <a
+			->
+				value = >b
+		sink
+			<-
+				value = <b
+		counter
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		BOOST_TEST(chain.parameters().details);
+		chain.enable();
+		auto const info = chain.exec();
+		auto const plain = chain.exec(false);
+		chain.disable();
+
+		BOOST_TEST(!info.success);
+		BOOST_TEST(!plain.details);
+		BOOST_TEST_REQUIRE(info.details);
+
+		auto const& details = *info.details;
+		BOOST_TEST_REQUIRE(details.modules.size() == 4);
+		BOOST_TEST(details.modules[0].type_name == "source");
+		BOOST_TEST((details.modules[0].outcome == module_outcome::success));
+		BOOST_TEST((details.modules[1].outcome == module_outcome::failed));
+		BOOST_TEST((details.modules[2].outcome == module_outcome::skipped));
+		BOOST_TEST((details.modules[3].outcome == module_outcome::success));
+
+		BOOST_TEST_REQUIRE(details.failed_module());
+		BOOST_TEST(details.failed_module()->number == 2);
+
+		for(auto const& module: details.modules){
+			if(module.outcome == module_outcome::skipped) continue;
+			BOOST_TEST((details.start <= module.start));
+			BOOST_TEST((module.start <= module.end));
+			BOOST_TEST((module.end <= details.end));
+			BOOST_TEST((module.wait <= module.end - module.start));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(external_arguments){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = adaptive
+		external
+			->
+				value = >a
+		frame_sink
+			<-
+				value = <a
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	chain.enable();
+
+	reset();
+	for(int i = 0; i < 3; ++i){
+		exec_arguments arguments;
+		arguments.emplace("value", frame(i));
+		BOOST_TEST(arguments.contains("value"));
+		BOOST_TEST(chain.exec(std::move(arguments)).success);
+		BOOST_TEST(results.back() == i);
+	}
+	BOOST_TEST(frame::copies == 0);
+
+	// missing and mistyped arguments let the exec fail
+	BOOST_TEST(!chain.exec().success);
+	exec_arguments mistyped;
+	mistyped.emplace("value", 5);
+	BOOST_TEST(!chain.exec(std::move(mistyped)).success);
+
+	chain.disable();
+
+	exec_arguments arguments;
+	arguments.emplace("a", 1);
+	BOOST_CHECK_THROW(arguments.emplace("a", 2), std::logic_error);
+	BOOST_TEST(arguments.take< int >("a") == 1);
+	BOOST_TEST(!arguments.contains("a"));
+	BOOST_CHECK_THROW(arguments.take< int >("a"), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(external_results){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		external
+			->
+				value = >a
+		result
+			<-
+				value = <a
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	chain.enable();
+
+	frame::copies = 0;
+	for(int i = 0; i < 3; ++i){
+		exec_arguments arguments;
+		arguments.emplace("value", frame(i));
+		auto info = chain.exec(std::move(arguments));
+		BOOST_TEST(info.success);
+		BOOST_TEST(info.results.contains("value"));
+
+		auto const result = info.results.take< std::vector< frame > >("value");
+		BOOST_TEST_REQUIRE(result.size() == 1);
+		BOOST_TEST(result[0].value == i);
+	}
+	BOOST_TEST(frame::copies == 0);
+
+	// a failed exec returns no result
+	auto const info = chain.exec();
+	BOOST_TEST(!info.success);
+	BOOST_TEST(info.results.size() == 0);
+
+	chain.disable();
+}
+
+BOOST_AUTO_TEST_CASE(unused_pure_modules){
+	for(auto const executor: {"parallel", "inline", "adaptive"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		// 2 is used by sink, 3 has no used output, 4 is only used by 5
+		// which has no used output, 6 is waited on by sink
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+			details = true
+		source
+			parameter
+				value = 1
+			->
+				value = >a
+		pure_increment
+			<-
+				value = &a
+			->
+				value = >b
+		pure_increment
+			<-
+				value = &a
+		pure_increment
+			<-
+				value = &a
+			->
+				value = >c
+		pure_increment
+			<-
+				value = <c
+		pure_increment
+			<-
+				value = <a
+		sink
+			wait_on = 6:pure_increment
+			<-
+				value = <b
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		reset();
+		chain.enable();
+		auto const info = chain.exec();
+		chain.disable();
+
+		BOOST_TEST(info.success);
+		BOOST_TEST_REQUIRE(info.details);
+		std::vector< std::size_t > numbers;
+		for(auto const& module: info.details->modules){
+			numbers.push_back(module.number);
+		}
+		BOOST_TEST((numbers == std::vector< std::size_t >{1, 2, 6, 7}));
+
+		std::lock_guard lock(mutex);
+		std::sort(results.begin(), results.end());
+		BOOST_TEST((results == std::vector< int >{-2, 1, 101, 101}));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(unused_consumer_of_stream_output){
+	for(auto const executor: {"parallel", "adaptive"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		// the output doesn't become a stream after the pure increment is
+		// removed, the sink still waits for the whole data
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+		stream_range
+			parameter
+				count = 100
+			->
+				value = >a
+		pure_increment
+			<-
+				value = &a
+		sink
+			<-
+				value = <a
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		reset();
+		chain.enable();
+		auto const info = chain.exec();
+		chain.disable();
+
+		BOOST_TEST(info.success);
+		std::lock_guard lock(mutex);
+		BOOST_TEST(results.size() == 100);
+		BOOST_TEST(std::count(results.begin(), results.end(), -99) == 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(memoized_module){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = inline
+		external
+			->
+				value = >a
+		frame_to_int
+			<-
+				value = <a
+			->
+				value = >b
+		memoized_increment
+			<-
+				value = <b
+			->
+				value = >c
+		sink
+			<-
+				value = <c
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	chain.enable();
+
+	reset();
+	for(int const value: {1, 1, 2, 1, 3, 1}){
+		exec_arguments arguments;
+		arguments.emplace("value", frame(value));
+		BOOST_TEST(chain.exec(std::move(arguments)).success);
+	}
+
+	// read before disable, it releases the cache
+	auto const metrics = chain.memoization();
+	chain.disable();
+
+	// the exec function only ran for 1, 2 and 3, the sink always
+	std::lock_guard lock(mutex);
+	BOOST_TEST((results == std::vector< int >{
+		101, -2, -2, 102, -3, -2, 103, -4, -2}));
+
+	BOOST_TEST_REQUIRE(metrics.size() == 1);
+	BOOST_TEST(metrics[0].number == 3);
+	BOOST_TEST(metrics[0].metrics.hits == 3);
+	BOOST_TEST(metrics[0].metrics.misses == 3);
+	BOOST_TEST(metrics[0].metrics.size == 2);
+	BOOST_TEST(metrics[0].metrics.capacity == 2);
+	BOOST_TEST(metrics[0].metrics.hit_rate() == 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(memoized_memory_usage){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = inline
+		external
+			->
+				value = >a
+		frame_to_int
+			<-
+				value = <a
+			->
+				value = >b
+		memoized_increment
+			<-
+				value = <b
+			->
+				value = >c
+		sink
+			<-
+				value = <c
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	chain.enable();
+
+	reset();
+	for(int const value: {1, 2, 3}){
+		exec_arguments arguments;
+		arguments.emplace("value", frame(value));
+		BOOST_TEST(chain.exec(std::move(arguments)).success);
+	}
+
+	// two entries of one input and one output int each
+	auto const metrics = chain.memoization();
+	BOOST_TEST_REQUIRE(metrics.size() == 1);
+	BOOST_TEST(metrics[0].metrics.size == 2);
+	BOOST_TEST(metrics[0].metrics.bytes == 4 * sizeof(int));
+	BOOST_TEST(chain.memory().current() == 4 * sizeof(int));
+
+	// over the budget the cache gives up its entries
+	chain.memory().set_budget(1);
+	{
+		exec_arguments arguments;
+		arguments.emplace("value", frame(4));
+		BOOST_TEST(chain.exec(std::move(arguments)).success);
+	}
+	BOOST_TEST(chain.memoization()[0].metrics.size == 0);
+	BOOST_TEST(chain.memory().current() == 0);
+	chain.memory().set_budget(0);
+
+	{
+		exec_arguments arguments;
+		arguments.emplace("value", frame(5));
+		BOOST_TEST(chain.exec(std::move(arguments)).success);
+	}
+	BOOST_TEST(chain.memory().current() == 2 * sizeof(int));
+
+	// disable releases the cache
+	chain.disable();
+	BOOST_TEST(chain.memoization()[0].metrics.size == 0);
+	BOOST_TEST(chain.memory().current() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(memoized_concurrent_misses){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = inline
+		external
+			->
+				value = >a
+		frame_to_int
+			<-
+				value = <a
+			->
+				value = >b
+		memoized_barrier_increment
+			<-
+				value = <b
+			->
+				value = >c
+		sink
+			<-
+				value = <c
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	chain.enable();
+
+	reset();
+	barrier_count = 0;
+	auto const exec = [&chain]{
+			exec_arguments arguments;
+			arguments.emplace("value", frame(1));
+			return chain.exec(std::move(arguments)).success;
+		};
+	auto first = std::async(std::launch::async, exec);
+	auto second = std::async(std::launch::async, exec);
+	BOOST_TEST(first.get());
+	BOOST_TEST(second.get());
+
+	// both execs missed, the second insert found the entry of the first
+	auto const metrics = chain.memoization();
+	BOOST_TEST_REQUIRE(metrics.size() == 1);
+	BOOST_TEST(metrics[0].metrics.misses == 2);
+	BOOST_TEST(metrics[0].metrics.size == 1);
+	BOOST_TEST(chain.memory().current() == 2 * sizeof(int));
+
+	chain.disable();
+}
+
+BOOST_AUTO_TEST_CASE(memoized_appender_outputs){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = inline
+		external
+			->
+				value = >a
+		frame_to_int
+			<-
+				value = <a
+			->
+				value = >b
+		memoized_appender_increment
+			<-
+				value = <b
+			->
+				value = >c
+		sink
+			<-
+				value = <c
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	chain.enable();
+
+	reset();
+	for(int const value: {1, 1}){
+		exec_arguments arguments;
+		arguments.emplace("value", frame(value));
+		BOOST_TEST(chain.exec(std::move(arguments)).success);
+	}
+
+	chain.disable();
+
+	// the cached outputs contain the committed appender data
+	std::lock_guard lock(mutex);
+	BOOST_TEST((results == std::vector< int >{101, -2, -2}));
+}
+
+BOOST_AUTO_TEST_CASE(memoized_unconnected_optional_input){
+	disposer::system system;
+	declare_modules(system.directory().declarant());
+
+	std::istringstream config(R"file(chain
+	c
+		parameter
+			executor = inline
+		external
+			->
+				value = >a
+		frame_to_int
+			<-
+				value = <a
+			->
+				value = >b
+		memoized_offset_increment
+			<-
+				value = <b
+			->
+				value = >c
+		sink
+			<-
+				value = <c
+)file");
+	system.load_config(config);
+
+	auto& chain = system.get_chain("c");
+	chain.enable();
+
+	reset();
+	for(int const value: {1, 1, 2}){
+		exec_arguments arguments;
+		arguments.emplace("value", frame(value));
+		BOOST_TEST(chain.exec(std::move(arguments)).success);
+	}
+
+	chain.disable();
+
+	std::lock_guard lock(mutex);
+	BOOST_TEST((results == std::vector< int >{101, -2, -2, 102, -3}));
+
+	auto const metrics = chain.memoization();
+	BOOST_TEST_REQUIRE(metrics.size() == 1);
+	BOOST_TEST(metrics[0].metrics.hits == 1);
+	BOOST_TEST(metrics[0].metrics.misses == 2);
+}
+
+BOOST_AUTO_TEST_CASE(memoized_consumer_of_stream_output){
+	for(auto const executor: {"parallel", "adaptive"}){
+		disposer::system system;
+		declare_modules(system.directory().declarant());
+
+		// the memoized module gets the whole data instead of a stream
+		std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+		stream_range
+			parameter
+				count = 100
+			->
+				value = >a
+		memoized_sum
+			<-
+				value = <a
+			->
+				value = >b
+		sink
+			<-
+				value = <b
+)file");
+		system.load_config(config);
+
+		auto& chain = system.get_chain("c");
+		chain.enable();
+		reset();
+		for(int i = 0; i < 2; ++i){
+			BOOST_TEST(chain.exec().success);
+		}
+		chain.disable();
+
+		std::lock_guard lock(mutex);
+		BOOST_TEST((results == std::vector< int >{4950, -4950, -4950}));
+
+		auto const metrics = chain.memoization();
+		BOOST_TEST_REQUIRE(metrics.size() == 1);
+		BOOST_TEST(metrics[0].metrics.hits == 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(stream_with_other_dependency){
+	// the consumer also depends on the producer directly or via increment,
+	// so the stream falls back to a normal output
+	auto const direct = R"file(
+		stream_sum
+			<-
+				first = <a
+				second = <n
+)file";
+	auto const indirect = R"file(
+		increment
+			<-
+				value = <n
+			->
+				value = >m
+		stream_sum
+			<-
+				first = <a
+				second = <m
+)file";
+
+	for(auto const executor: {"parallel", "adaptive"}){
+		for(auto const consumer: {direct, indirect}){
+			disposer::system system;
+			declare_modules(system.directory().declarant());
+
+			std::istringstream config(std::string(R"file(chain
+	c
+		parameter
+			executor = )file") + executor + R"file(
+		stream_range
+			parameter
+				count = 100
+			->
+				value = >a
+				count = >n)file" + consumer);
+			system.load_config(config);
+
+			auto& chain = system.get_chain("c");
+			reset();
+			chain.enable();
+			auto const info = chain.exec();
+			chain.disable();
+
+			BOOST_TEST(info.success);
+			std::lock_guard lock(mutex);
+			BOOST_TEST(std::count(results.begin(), results.end(), 4950) == 1);
+		}
+	}
+}
@@ -0,0 +1,226 @@
+#include <disposer/core/executor.hpp>
+
+#define BOOST_TEST_MODULE disposer executor
+#include <boost/test/included/unit_test.hpp>
+
+#include <condition_variable>
+
+
+using namespace disposer;
+
+
+BOOST_AUTO_TEST_CASE(run_all_tasks){
+	std::atomic< int > count{0};
+	{
+		executor pool(4);
+		BOOST_TEST(pool.worker_count() == 4);
+		for(int i = 0; i < 1000; ++i){
+			pool.post([&count]{ ++count; });
+		}
+	}
+	BOOST_TEST(count == 1000);
+}
+
+BOOST_AUTO_TEST_CASE(compensate_blocked_worker){
+	executor pool(1);
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool ready = false;
+	bool done = false;
+
+	// the only worker blocks until the second task ran
+	pool.post([&]{
+			BOOST_TEST(pool.is_worker_thread());
+			std::unique_lock lock(mutex);
+			managed_blocking blocking;
+			cv.wait(lock, [&ready]{ return ready; });
+			done = true;
+			cv.notify_all();
+		});
+
+	pool.post([&]{
+			std::lock_guard lock(mutex);
+			ready = true;
+			cv.notify_all();
+		});
+
+	std::unique_lock lock(mutex);
+	cv.wait(lock, [&done]{ return done; });
+	BOOST_TEST(!pool.is_worker_thread());
+}
+
+BOOST_AUTO_TEST_CASE(resize){
+	executor pool(1);
+	std::atomic< int > count{0};
+	pool.post([&count]{ ++count; });
+	pool.set_worker_count(3);
+	BOOST_TEST(pool.worker_count() == 3);
+	for(int i = 0; i < 100; ++i) pool.post([&count]{ ++count; });
+	pool.set_worker_count(1);
+	for(int i = 0; i < 100; ++i) pool.post([&count]{ ++count; });
+	while(count != 201) std::this_thread::yield();
+}
+
+BOOST_AUTO_TEST_CASE(spinning_workers){
+	executor pool(2);
+	pool.set_spinning(2, std::chrono::milliseconds(50));
+	BOOST_TEST(pool.spinning_worker_count() == 2);
+	BOOST_TEST((pool.spin_duration() == std::chrono::milliseconds(50)));
+
+	// a chain of handoffs, every task posts the next one
+	std::atomic< int > count{0};
+	std::function< void() > next = [&]{
+			if(++count < 1000) pool.post([&]{ next(); });
+		};
+	pool.post([&]{ next(); });
+	while(count != 1000) std::this_thread::yield();
+
+	// spinning workers sleep after the duration and still get new tasks
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	pool.post([&count]{ ++count; });
+	while(count != 1001) std::this_thread::yield();
+
+	pool.set_spinning(0);
+	BOOST_TEST(pool.spinning_worker_count() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(elastic){
+	executor pool(1);
+	pool.set_elastic(1, 4, std::chrono::milliseconds(20));
+	BOOST_TEST(pool.is_elastic());
+	BOOST_TEST(pool.min_worker_count() == 1);
+	BOOST_TEST(pool.max_worker_count() == 4);
+
+	// a burst of blocking tasks grows the pool up to its maximum
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool release = false;
+	std::atomic< int > running{0};
+	for(int i = 0; i < 8; ++i){
+		pool.post([&]{
+				++running;
+				std::unique_lock lock(mutex);
+				cv.wait(lock, [&release]{ return release; });
+			});
+	}
+	while(running != 4) std::this_thread::yield();
+	BOOST_TEST(pool.worker_count() == 4);
+
+	{
+		std::lock_guard lock(mutex);
+		release = true;
+	}
+	cv.notify_all();
+	while(running != 8) std::this_thread::yield();
+
+	// idle workers end after the timeout
+	while(pool.worker_count() != 1) std::this_thread::yield();
+
+	auto const metrics = pool.metrics();
+	BOOST_TEST(metrics.peak_worker_count == 4);
+	BOOST_TEST(metrics.grow_count == 3);
+	BOOST_TEST(metrics.shrink_count == 3);
+
+	std::atomic< int > count{0};
+	pool.post([&count]{ ++count; });
+	while(count != 1) std::this_thread::yield();
+
+	pool.set_worker_count(2);
+	BOOST_TEST(!pool.is_elastic());
+}
+
+BOOST_AUTO_TEST_CASE(scheduling_classes){
+	executor pool(1);
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool release = false;
+	std::vector< char > order;
+
+	// the only worker is blocked while the tasks are queued
+	std::atomic< bool > blocked{false};
+	pool.post([&]{
+			std::unique_lock lock(mutex);
+			blocked = true;
+			cv.wait(lock, [&release]{ return release; });
+		});
+	while(!blocked) std::this_thread::yield();
+
+	auto const record = [&](char const c){
+			return [&order, c]{ order.push_back(c); };
+		};
+
+	scheduling_class background(0, 1);
+	scheduling_class weighted(0, 3);
+	scheduling_class interactive(1);
+
+	auto const now = std::chrono::steady_clock::now();
+	for(int i = 0; i < 4; ++i){
+		pool.post(record('b'), background);
+		pool.post(record('w'), weighted);
+		pool.post(record('w'), weighted);
+		pool.post(record('w'), weighted);
+	}
+	pool.post(record('2'), interactive, now + std::chrono::seconds(2));
+	pool.post(record('1'), interactive, now + std::chrono::seconds(1));
+	pool.post(record('i'), interactive);
+
+	std::atomic< bool > done{false};
+	pool.post([&done]{ done = true; }, background);
+
+	{
+		std::lock_guard lock(mutex);
+		release = true;
+	}
+	cv.notify_all();
+	while(!done) std::this_thread::yield();
+
+	// priority first, earliest deadline first, tasks without deadline last
+	BOOST_TEST_REQUIRE(order.size() == 19);
+	BOOST_TEST(std::string(order.begin(), order.begin() + 3) == "12i");
+
+	// the weighted class gets 3 of 4 slots
+	auto const first_half = std::string(order.begin() + 3, order.begin() + 11);
+	BOOST_TEST(std::count(first_half.begin(), first_half.end(), 'w') == 6);
+}
+
+BOOST_AUTO_TEST_CASE(worker_affinity){
+	executor pool(3);
+	BOOST_TEST(pool.current_worker() == executor::no_worker);
+
+	scheduling_class cls;
+	auto const wait_idle = [&pool]{
+			while(pool.idle_worker_count() != 3) std::this_thread::yield();
+		};
+
+	std::atomic< std::size_t > worker{executor::no_worker};
+	pool.post([&]{ worker = pool.current_worker(); });
+	while(worker == executor::no_worker) std::this_thread::yield();
+	BOOST_TEST(worker < 3);
+
+	// an idle preferred worker runs the task itself
+	for(int i = 0; i < 20; ++i){
+		wait_idle();
+		std::atomic< std::size_t > ran_on{executor::no_worker};
+		pool.post([&]{ ran_on = pool.current_worker(); },
+			cls, executor::time_point::max(), worker);
+		while(ran_on == executor::no_worker) std::this_thread::yield();
+		BOOST_TEST(ran_on == worker);
+	}
+
+	// a busy preferred worker lets other workers take the task
+	std::atomic< bool > release{false};
+	std::atomic< bool > blocked{false};
+	std::atomic< std::size_t > ran_on{executor::no_worker};
+	wait_idle();
+	pool.post([&]{
+			blocked = true;
+			pool.post([&]{ ran_on = pool.current_worker(); },
+				cls, executor::time_point::max(), pool.current_worker());
+			while(!release) std::this_thread::yield();
+		}, cls, executor::time_point::max(), worker);
+	while(ran_on == executor::no_worker) std::this_thread::yield();
+	BOOST_TEST(ran_on != worker);
+	release = true;
+}
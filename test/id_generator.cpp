@@ -0,0 +1,56 @@
+#include <disposer/core/id_generator.hpp>
+
+#define BOOST_TEST_MODULE disposer id_generator
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+
+using namespace disposer;
+
+
+BOOST_AUTO_TEST_CASE(dense){
+	id_generator generate;
+	BOOST_TEST(generate.block_size() == 1);
+	for(std::size_t i = 0; i < 100; ++i){
+		BOOST_TEST(generate() == i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(blocks_per_thread){
+	id_generator generate(16);
+	BOOST_TEST(generate.block_size() == 16);
+
+	std::vector< std::vector< std::size_t > > ids(4);
+	std::vector< std::thread > threads;
+	for(auto& list: ids){
+		threads.emplace_back([&generate, &list]{
+				for(int i = 0; i < 1000; ++i) list.push_back(generate());
+			});
+	}
+	for(auto& thread: threads) thread.join();
+
+	std::vector< std::size_t > all;
+	for(auto const& list: ids){
+		// increasing per thread
+		BOOST_TEST(std::is_sorted(list.begin(), list.end()));
+		all.insert(all.end(), list.begin(), list.end());
+	}
+
+	// unique over all threads
+	std::sort(all.begin(), all.end());
+	BOOST_TEST((std::adjacent_find(all.begin(), all.end()) == all.end()));
+}
+
+BOOST_AUTO_TEST_CASE(generators_keep_their_blocks){
+	id_generator first(8);
+	id_generator second(8);
+
+	// alternating doesn't throw the block of the other generator away
+	for(std::size_t i = 0; i < 20; ++i){
+		BOOST_TEST(first() == i);
+		BOOST_TEST(second() == i);
+	}
+}
@@ -0,0 +1,90 @@
+#include <disposer/core/exec_output.hpp>
+
+#define BOOST_TEST_MODULE disposer memory_usage
+#include <boost/test/included/unit_test.hpp>
+
+#include <thread>
+
+
+using namespace disposer;
+using namespace disposer::literals;
+
+
+struct sized{
+	std::size_t memory_size()const noexcept{ return 100; }
+};
+
+
+BOOST_AUTO_TEST_CASE(size_hook){
+	BOOST_TEST(memory_size< int >{}(5) == sizeof(int));
+	BOOST_TEST(memory_size< sized >{}(sized{}) == 100);
+}
+
+BOOST_AUTO_TEST_CASE(parent_and_peak){
+	memory_usage system;
+	memory_usage chain(&system);
+
+	chain.add(10);
+	chain.add(20);
+	chain.sub(25);
+
+	BOOST_TEST(chain.current() == 5);
+	BOOST_TEST(chain.peak() == 30);
+	BOOST_TEST(system.current() == 5);
+	BOOST_TEST(system.peak() == 30);
+}
+
+BOOST_AUTO_TEST_CASE(exec_output_accounting){
+	memory_usage usage;
+
+	output< decltype("o"_out), sized > o{1};
+	output_map_type map;
+	exec_output< decltype("o"_out), sized > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	eo.set_memory_usage(&usage);
+
+	eo.push(sized{});
+	eo.emplace();
+	BOOST_TEST(usage.current() == 200);
+
+	eo.cleanup();
+	BOOST_TEST(usage.current() == 0);
+	BOOST_TEST(usage.peak() == 200);
+}
+
+BOOST_AUTO_TEST_CASE(budget){
+	memory_usage system;
+	memory_usage chain(&system);
+	system.set_budget(100);
+
+	chain.add(150);
+
+	std::thread release([&chain]{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			chain.sub(150);
+		});
+
+	chain.wait_for_budget();
+	BOOST_TEST(system.current() == 0);
+
+	release.join();
+}
+
+BOOST_AUTO_TEST_CASE(cached_data){
+	memory_usage system;
+	memory_usage chain(&system);
+	system.set_budget(100);
+
+	chain.add_cached(150);
+	BOOST_TEST(chain.cached() == 150);
+	BOOST_TEST(system.cached() == 150);
+	BOOST_TEST(system.current() == 150);
+	BOOST_TEST(chain.over_budget());
+
+	// doesn't block, the cache releases its data by itself
+	chain.wait_for_budget();
+
+	chain.sub_cached(150);
+	BOOST_TEST(system.cached() == 0);
+	BOOST_TEST(system.current() == 0);
+}
@@ -0,0 +1,58 @@
+#include <disposer/tool/mpmc_queue.hpp>
+
+#define BOOST_TEST_MODULE disposer mpmc_queue
+#include <boost/test/included/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+
+using namespace disposer;
+
+
+BOOST_AUTO_TEST_CASE(bounded){
+	mpmc_queue< int > queue(3);
+	BOOST_TEST(queue.capacity() == 4);
+	BOOST_TEST(queue.empty());
+
+	for(int i = 0; i < 4; ++i) BOOST_TEST(queue.try_emplace(i));
+	BOOST_TEST(!queue.try_emplace(4));
+
+	for(int i = 0; i < 4; ++i){
+		auto const value = queue.try_pop();
+		BOOST_TEST_REQUIRE(value.has_value());
+		BOOST_TEST(*value == i);
+	}
+	BOOST_TEST(!queue.try_pop());
+	BOOST_TEST(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent){
+	mpmc_queue< std::size_t > queue(64);
+	constexpr std::size_t count = 10000;
+
+	std::atomic< std::size_t > sum{0};
+	std::atomic< std::size_t > popped{0};
+
+	std::vector< std::thread > threads;
+	for(std::size_t i = 0; i < 2; ++i){
+		threads.emplace_back([&]{
+				for(std::size_t j = 1; j <= count; ++j){
+					while(!queue.try_emplace(j)) std::this_thread::yield();
+				}
+			});
+		threads.emplace_back([&]{
+				while(popped < 2 * count){
+					if(auto const value = queue.try_pop()){
+						sum += *value;
+						++popped;
+					}else{
+						std::this_thread::yield();
+					}
+				}
+			});
+	}
+	for(auto& thread: threads) thread.join();
+
+	BOOST_TEST(sum == count * (count + 1));
+}
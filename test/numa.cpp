@@ -0,0 +1,66 @@
+#include <disposer/tool/numa.hpp>
+
+#define BOOST_TEST_MODULE disposer numa
+#include <boost/test/included/unit_test.hpp>
+
+#include <numeric>
+#include <vector>
+
+
+using namespace disposer;
+
+
+BOOST_AUTO_TEST_CASE(topology){
+	BOOST_TEST(numa_node_count() >= 1);
+	BOOST_TEST(current_numa_node() < 64);
+}
+
+BOOST_AUTO_TEST_CASE(node_list){
+	auto const single = detail::parse_numa_node_list("0");
+	BOOST_TEST(single.count == 1);
+	BOOST_TEST(single.mask == 0x1);
+
+	auto const range = detail::parse_numa_node_list("0-3");
+	BOOST_TEST(range.count == 4);
+	BOOST_TEST(range.mask == 0xF);
+
+	// memoryless node 1 is not in the list
+	auto const sparse = detail::parse_numa_node_list("0,2");
+	BOOST_TEST(sparse.count == 2);
+	BOOST_TEST(sparse.mask == 0x5);
+
+	auto const mixed = detail::parse_numa_node_list("0-1,4,6-7");
+	BOOST_TEST(mixed.count == 5);
+	BOOST_TEST(mixed.mask == 0xD3);
+
+	// node numbers beyond the mask are counted, but disable the mask
+	auto const large = detail::parse_numa_node_list("0,70");
+	BOOST_TEST(large.count == 2);
+	BOOST_TEST(large.mask == 0);
+
+	auto const empty = detail::parse_numa_node_list("");
+	BOOST_TEST(empty.count == 1);
+	BOOST_TEST(empty.mask == 0x1);
+
+	auto const invalid = detail::parse_numa_node_list("x");
+	BOOST_TEST(invalid.count == 1);
+	BOOST_TEST(invalid.mask == 0x1);
+}
+
+BOOST_AUTO_TEST_CASE(memory_policy){
+	for(auto const node: {numa_all_nodes, current_numa_node()}){
+		std::vector< int > data;
+		{
+			numa_memory_policy const policy(node);
+
+			// the policy is only set on NUMA systems
+			if(numa_node_count() < 2) BOOST_TEST(!policy.active());
+
+			data.resize(1 << 18);
+			std::iota(data.begin(), data.end(), 0);
+		}
+
+		BOOST_TEST(data[0] == 0);
+		BOOST_TEST(data[(1 << 18) - 1] == (1 << 18) - 1);
+	}
+}
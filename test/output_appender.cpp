@@ -0,0 +1,115 @@
+#include <disposer/core/input.hpp>
+#include <disposer/core/exec_input.hpp>
+
+#define BOOST_TEST_MODULE disposer output_appender
+#include <boost/test/included/unit_test.hpp>
+
+#include <thread>
+
+
+using namespace disposer;
+using namespace disposer::literals;
+
+
+BOOST_AUTO_TEST_CASE(ordered_merge){
+	memory_usage usage;
+
+	output< decltype("o"_out), int > o{1};
+	input< decltype("i"_in), int, true > i{&o};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	eo.set_memory_usage(&usage);
+	exec_input< decltype("i"_in), int, true > ei(
+		hana::tuple< input< decltype("i"_in), int, true > const&,
+			output_map_type const& >{i, map});
+
+	std::vector< std::thread > threads;
+	for(std::size_t t = 0; t < 8; ++t){
+		threads.emplace_back([&eo, t]{
+				auto appender = eo.appender(t);
+				for(int j = 0; j < 100; ++j){
+					appender.push(static_cast< int >(t) * 100 + j);
+				}
+			});
+	}
+	for(auto& thread: threads) thread.join();
+
+	eo.close(true);
+	BOOST_TEST(usage.current() == 800 * sizeof(int));
+
+	auto const data = ei.references();
+	BOOST_TEST(data.size() == 800);
+	for(std::size_t j = 0; j < data.size(); ++j){
+		BOOST_TEST(data[j] == static_cast< int >(j));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(commit_into_stream){
+	output< decltype("o"_out), int > o{1, 16};
+	input< decltype("i"_in), int, true > i{&o};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	exec_input< decltype("i"_in), int, true > ei(
+		hana::tuple< input< decltype("i"_in), int, true > const&,
+			output_map_type const& >{i, map});
+
+	std::thread producer([&eo]{
+			{
+				auto appender = eo.appender();
+				appender.push(1);
+				appender.push(2);
+			}
+			eo.close(true);
+		});
+
+	int sum = 0;
+	for(auto&& value: ei.stream()) sum += value;
+	BOOST_TEST(sum == 3);
+
+	producer.join();
+	ei.cleanup();
+}
+
+namespace{
+
+	// throws on move after fail is set
+	struct fragile{
+		fragile(int value): value(value) {}
+		fragile(fragile const&) = default;
+		fragile(fragile&& other): value(other.value){
+			if(fail) throw std::runtime_error("fragile move");
+		}
+
+		int value;
+		static bool fail;
+	};
+
+	bool fragile::fail = false;
+
+}
+
+BOOST_AUTO_TEST_CASE(destructor_catches_errors){
+	output< decltype("o"_out), fragile > o{1, 16};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), fragile > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+
+	{
+		auto appender = eo.appender();
+		appender.push(fragile(1));
+		fragile::fail = true;
+		BOOST_CHECK_THROW(appender.commit(), std::runtime_error);
+
+		fragile const value(2);
+		appender.push(value);
+		// the destructor logs the error instead of terminating
+	}
+
+	fragile::fail = false;
+	eo.close(true);
+}
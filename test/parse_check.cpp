@@ -82,9 +82,14 @@ namespace disposer{ namespace types{ namespace parse{
 			<< v.inputs << "," << v.outputs << "}";
 	}
 
+	std::ostream& operator<<(std::ostream& os, chain_parameter const& v){
+		return os << "{" << v.key << "," << v.value << "}";
+	}
+
 	std::ostream& operator<<(std::ostream& os, chain const& v){
 		return os << "{" << v.name << ","
-			<< *v.id_generator << "," << v.modules << "}";
+			<< v.id_generator << "," << v.modules << ","
+			<< v.parameters << "}";
 	}
 
 	std::ostream& operator<<(std::ostream& os, component const& v){
@@ -156,13 +161,22 @@ namespace disposer{ namespace types{ namespace parse{
 			&& l.outputs == r.outputs;
 	}
 
+	bool operator==(
+		chain_parameter const& l,
+		chain_parameter const& r
+	){
+		return l.key == r.key
+			&& l.value == r.value;
+	}
+
 	bool operator==(
 		chain const& l,
 		chain const& r
 	){
 		return l.name == r.name
 			&& l.id_generator == r.id_generator
-			&& l.modules == r.modules;
+			&& l.modules == r.modules
+			&& l.parameters == r.parameters;
 	}
 
 	bool operator==(
@@ -285,6 +299,54 @@ chain
 								{"out", "x1"}
 							}
 						}
+					},
+					{}
+				}
+			}
+		}
+	},
+	{
+R"file(chain
+	chain1 = gen
+		parameter
+			executor = inline
+		mod1
+			->
+				out = >x1
+		mod2
+			<-
+				in = <x1
+)file"
+	,
+		config{
+			{},
+			{},
+			{
+				{
+					"chain1",
+					{"gen"},
+					{
+						{
+							"mod1",
+							{},
+							{},
+							{},
+							{
+								{"out", "x1"}
+							}
+						},
+						{
+							"mod2",
+							{},
+							{},
+							{
+								{"in", disposer::in_transfer::move, "x1"}
+							},
+							{}
+						}
+					},
+					{
+						{"executor", "inline"}
 					}
 				}
 			}
@@ -0,0 +1,74 @@
+#include <disposer/tool/input_data.hpp>
+#include <disposer/tool/soa_vector.hpp>
+
+#include <boost/hana/define_struct.hpp>
+#include <boost/hana/string.hpp>
+
+#define BOOST_TEST_MODULE disposer span
+#include <boost/test/included/unit_test.hpp>
+
+#include <numeric>
+
+
+using namespace disposer;
+
+
+struct point{
+	BOOST_HANA_DEFINE_STRUCT(point,
+		(float, x),
+		(float, y),
+		(int, id)
+	);
+};
+
+
+BOOST_AUTO_TEST_CASE(span_basics){
+	std::vector< int > data{1, 2, 3, 4};
+	span< int > s(data);
+	span< int const > cs(s);
+
+	BOOST_TEST(s.size() == 4);
+	BOOST_TEST(s.size_bytes() == 4 * sizeof(int));
+	BOOST_TEST(cs.data() == data.data());
+	BOOST_TEST(s.subspan(1, 2)[0] == 2);
+	BOOST_TEST(s.last(1).front() == 4);
+	BOOST_TEST(std::accumulate(cs.begin(), cs.end(), 0) == 10);
+
+	for(auto& v: s) v *= 2;
+	BOOST_TEST(data[3] == 8);
+}
+
+BOOST_AUTO_TEST_CASE(input_data_spans){
+	std::vector< float > data{1, 2, 3};
+
+	input_data_r< float > const r(data);
+	BOOST_TEST(r.as_span().data() == data.data());
+	BOOST_TEST(r.as_span().size() == 3);
+
+	input_data_v< float > v{std::vector< float >(data)};
+	for(auto& value: v.as_span()) value += 1;
+	BOOST_TEST(v[2] == 4);
+	BOOST_TEST(data[2] == 3);
+}
+
+BOOST_AUTO_TEST_CASE(soa_vector_columns){
+	soa_vector< point > points;
+	BOOST_TEST(points.empty());
+
+	points.push_back(point{1, 2, 7});
+	points.push_back(point{3, 4, 8});
+	BOOST_TEST(points.size() == 2);
+
+	auto xs = points.column(BOOST_HANA_STRING("x"));
+	BOOST_TEST(xs.size() == 2);
+	for(auto& x: xs) x *= 10;
+
+	auto const& cpoints = points;
+	auto ids = cpoints.column(BOOST_HANA_STRING("id"));
+	BOOST_TEST(ids[1] == 8);
+
+	auto const p = points[1];
+	BOOST_TEST(p.x == 30);
+	BOOST_TEST(p.y == 4);
+	BOOST_TEST(p.id == 8);
+}
@@ -0,0 +1,108 @@
+#include <disposer/core/input.hpp>
+#include <disposer/core/exec_input.hpp>
+
+#define BOOST_TEST_MODULE disposer spill
+#include <boost/test/included/unit_test.hpp>
+
+#include <numeric>
+
+
+using namespace disposer;
+using namespace disposer::literals;
+
+
+BOOST_AUTO_TEST_CASE(mapped_buffer_memory){
+	mapped_buffer buffer(4096);
+	BOOST_TEST(buffer.size() == 4096);
+
+	auto const data = static_cast< unsigned char* >(buffer.data());
+	data[0] = 1;
+	data[4095] = 2;
+	BOOST_TEST(data[0] == 1);
+	BOOST_TEST(data[4095] == 2);
+}
+
+BOOST_AUTO_TEST_CASE(spill_above_threshold){
+	memory_usage usage;
+
+	output< decltype("o"_out), int > o{2, 0, 64};
+	input< decltype("i"_in), int, true > i{&o};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	eo.set_memory_usage(&usage);
+	exec_input< decltype("i"_in), int, true > ei(
+		hana::tuple< input< decltype("i"_in), int, true > const&,
+			output_map_type const& >{i, map});
+
+	for(int j = 0; j < 100; ++j) eo.push(j);
+	BOOST_TEST(usage.current() == 100 * sizeof(int));
+
+	eo.close(true);
+	BOOST_TEST(eo.is_spilled());
+	BOOST_TEST(usage.current() == 0);
+
+	{
+		auto const data = ei.references();
+		BOOST_TEST(data.size() == 100);
+		BOOST_TEST(std::accumulate(data.begin(), data.end(), 0) == 4950);
+	}
+
+	{
+		auto const data = ei.values();
+		BOOST_TEST(data.size() == 100);
+		BOOST_TEST(data[99] == 99);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(spill_under_memory_pressure){
+	memory_usage usage;
+	usage.set_budget(8);
+
+	output< decltype("o"_out), int > o{1, 0, 1024};
+	input< decltype("i"_in), int, true > i{&o};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	eo.set_memory_usage(&usage);
+	exec_input< decltype("i"_in), int, true > ei(
+		hana::tuple< input< decltype("i"_in), int, true > const&,
+			output_map_type const& >{i, map});
+
+	eo.push(1);
+	eo.push(2);
+	eo.push(3);
+	eo.close(true);
+	BOOST_TEST(eo.is_spilled());
+
+	int sum = 0;
+	for(auto&& value: ei.stream()) sum += value;
+	BOOST_TEST(sum == 6);
+
+	ei.cleanup();
+	BOOST_TEST(usage.current() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(no_spill_below_threshold){
+	output< decltype("o"_out), int > o{1, 0, 1024};
+	input< decltype("i"_in), int, true > i{&o};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+
+	eo.push(1);
+	eo.close(true);
+	BOOST_TEST(!eo.is_spilled());
+}
+
+BOOST_AUTO_TEST_CASE(reject_unspillable_types){
+	using string_output = output< decltype("o"_out), std::string >;
+	using bool_output = output< decltype("o"_out), bool >;
+
+	BOOST_CHECK_THROW(string_output(1, 0, 1024), std::logic_error);
+	BOOST_CHECK_THROW(bool_output(1, 0, 1024), std::logic_error);
+	BOOST_CHECK_NO_THROW(string_output(1, 0, 0));
+}
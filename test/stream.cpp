@@ -0,0 +1,140 @@
+#include <disposer/core/input.hpp>
+#include <disposer/core/exec_input.hpp>
+
+#define BOOST_TEST_MODULE disposer stream
+#include <boost/test/included/unit_test.hpp>
+
+#include <thread>
+
+
+using namespace disposer;
+using namespace disposer::literals;
+
+
+BOOST_AUTO_TEST_CASE(stream_channel_order){
+	stream_channel< int > channel(2);
+
+	std::thread producer([&channel]{
+			for(int i = 0; i < 100; ++i) channel.emplace(i);
+			channel.close(true);
+		});
+
+	int expected = 0;
+	while(auto value = channel.pop()){
+		BOOST_TEST(*value == expected);
+		++expected;
+	}
+	BOOST_TEST(expected == 100);
+
+	producer.join();
+}
+
+BOOST_AUTO_TEST_CASE(stream_channel_abort){
+	stream_channel< int > channel(4);
+	channel.emplace(1);
+	channel.close(false);
+	BOOST_CHECK_THROW(channel.pop(), stream_aborted);
+}
+
+BOOST_AUTO_TEST_CASE(stream_channel_abandon){
+	stream_channel< int > channel(1);
+
+	std::thread producer([&channel]{
+			// second emplace would block forever without abandon
+			BOOST_TEST(channel.emplace(1));
+			BOOST_TEST(!channel.emplace(2));
+			channel.close(true);
+		});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	channel.abandon();
+
+	producer.join();
+}
+
+BOOST_AUTO_TEST_CASE(input_stream_of_stream_output){
+	output< decltype("o"_out), int > o{1, 4};
+	input< decltype("i"_in), int, true > i{&o};
+
+	BOOST_TEST(o.is_stream());
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	exec_input< decltype("i"_in), int, true > ei(
+		hana::tuple< input< decltype("i"_in), int, true > const&,
+			output_map_type const& >{i, map});
+
+	BOOST_TEST(eo.is_stream());
+
+	std::thread producer([&eo]{
+			for(int j = 0; j < 50; ++j) eo.push(j);
+			eo.close(true);
+		});
+
+	int expected = 0;
+	for(auto&& value: ei.stream()){
+		BOOST_TEST(value == expected);
+		++expected;
+	}
+	BOOST_TEST(expected == 50);
+
+	producer.join();
+	ei.cleanup();
+}
+
+BOOST_AUTO_TEST_CASE(input_stream_after_references){
+	output< decltype("o"_out), int > o{1, 4};
+	input< decltype("i"_in), int, true > i{&o};
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	exec_input< decltype("i"_in), int, true > ei(
+		hana::tuple< input< decltype("i"_in), int, true > const&,
+			output_map_type const& >{i, map});
+
+	std::thread producer([&eo]{
+			for(int j = 0; j < 10; ++j) eo.push(j);
+			eo.close(true);
+		});
+
+	// drains the stream
+	BOOST_TEST(ei.references().size() == 10);
+	producer.join();
+
+	int expected = 0;
+	for(auto&& value: ei.stream()){
+		BOOST_TEST(value == expected);
+		++expected;
+	}
+	BOOST_TEST(expected == 10);
+
+	ei.cleanup();
+}
+
+BOOST_AUTO_TEST_CASE(input_stream_of_normal_output){
+	output< decltype("o"_out), int > o{2, 4};
+	input< decltype("i"_in), int, true > i{&o};
+
+	// more than one connected input disables streaming
+	BOOST_TEST(!o.is_stream());
+
+	output_map_type map;
+	exec_output< decltype("o"_out), int > eo(
+		exec_output_init_data(o, map, 0, std::string()));
+	exec_input< decltype("i"_in), int, true > ei(
+		hana::tuple< input< decltype("i"_in), int, true > const&,
+			output_map_type const& >{i, map});
+
+	eo.push(1);
+	eo.push(2);
+	eo.close(true);
+
+	int sum = 0;
+	for(auto&& value: ei.stream()) sum += value;
+	BOOST_TEST(sum == 3);
+
+	auto const data = ei.references();
+	BOOST_TEST(data.size() == 2);
+}